@@ -0,0 +1,132 @@
+#ifndef BENCHLAYOUTS_HPP
+#define BENCHLAYOUTS_HPP
+
+#include "../includes/datatypes.hpp"
+#include "../includes/initSim.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic warehouse for the benchmarks: width x height aisle junctions
+// with the segment lengths initGraphLayout uses. Coordinates match the
+// edge lengths, and about 'blockedPercent' of the segments are left out
+// (shelf blocks) so routes are not just Manhattan paths.
+inline void generateGridLayout(int width, int height, unsigned seed, int blockedPercent = 10) {
+    static const double LENGTHS[] = {3.0, 4.0, 5.0, 8.0, 10.0};
+
+    nodes.clear();
+    adj.clear();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pickLength(0, 4);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<double> columnX(width, 0.0);
+    std::vector<double> rowY(height, 0.0);
+    for (int c = 1; c < width; ++c) columnX[c] = columnX[c - 1] + LENGTHS[pickLength(rng)];
+    for (int r = 1; r < height; ++r) rowY[r] = rowY[r - 1] + LENGTHS[pickLength(rng)];
+
+    nodes.reserve(static_cast<size_t>(width) * height);
+    adj.reserve(static_cast<size_t>(width) * height);
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            addNode(Node{ .id = "j_" + std::to_string(r) + "_" + std::to_string(c), .type = NodeType::Junction,
+                          .maxRobots = 1, .data = FrontDesk{0}, .x = columnX[c], .y = rowY[r] });
+        }
+    }
+
+    // The outer ring is always open; an inner junction is only cut off
+    // if all four of its segments happen to be blocked
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            int u = r * width + c;
+            if (c + 1 < width && (r == 0 || r == height - 1 || percent(rng) >= blockedPercent)) {
+                addEdge(u, u + 1, columnX[c + 1] - columnX[c], false);
+            }
+            if (r + 1 < height && (c == 0 || c == width - 1 || percent(rng) >= blockedPercent)) {
+                addEdge(u, u + width, rowY[r + 1] - rowY[r], false);
+            }
+        }
+    }
+}
+
+// Picking-aisle warehouse: 'aisles' parallel aisles of 'depth' pick
+// positions, joined by two-way cross aisles at the front, the back and
+// every 'crossEvery' positions. Most aisles are one-way, alternating in
+// direction so traffic snakes through the racks; about 'twoWayPercent'
+// of them are wide enough for two-way traffic. A front desk and a dock
+// sit at the two ends of the front cross aisle.
+struct AisleLayout {
+    int frontDesk = -1;
+    int dock = -1;
+    std::vector<int> pickFaces;     // Positions outside the cross aisles, nearest the front first
+};
+
+inline AisleLayout generateAisleLayout(int aisles, int depth, unsigned seed, int crossEvery = 25,
+                                       int twoWayPercent = 20) {
+    const double AISLE_SPACING = 3.0;
+    const double SLOT_PITCH = 1.0;
+
+    nodes.clear();
+    adj.clear();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    size_t total = static_cast<size_t>(aisles) * depth + 2;
+    nodes.reserve(total);
+    adj.reserve(total);
+
+    auto isCrossRow = [&](int row) { return row == 0 || row == depth - 1 || row % crossEvery == 0; };
+    for (int row = 0; row < depth; ++row) {
+        for (int aisle = 0; aisle < aisles; ++aisle) {
+            addNode(Node{ .id = "a_" + std::to_string(aisle) + "_" + std::to_string(row), .type = NodeType::Junction,
+                          .maxRobots = 1, .data = FrontDesk{0}, .x = aisle * AISLE_SPACING, .y = row * SLOT_PITCH });
+        }
+    }
+
+    for (int aisle = 0; aisle < aisles; ++aisle) {
+        bool twoWay = aisles < 2 || percent(rng) < twoWayPercent;
+        bool inbound = aisle % 2 == 1;   // Towards the front
+        for (int row = 0; row + 1 < depth; ++row) {
+            int u = row * aisles + aisle;
+            int v = u + aisles;
+            if (twoWay) {
+                addEdge(u, v, SLOT_PITCH, false);
+            } else if (inbound) {
+                addEdge(v, u, SLOT_PITCH, true);
+            } else {
+                addEdge(u, v, SLOT_PITCH, true);
+            }
+        }
+    }
+    for (int row = 0; row < depth; ++row) {
+        if (!isCrossRow(row)) continue;
+        for (int aisle = 0; aisle + 1 < aisles; ++aisle) {
+            int u = row * aisles + aisle;
+            addEdge(u, u + 1, AISLE_SPACING, false);
+        }
+    }
+
+    AisleLayout layout;
+    layout.frontDesk = addNode(Node{ .id = "front_desk", .type = NodeType::FrontDesk, .maxRobots = 2,
+                                     .data = FrontDesk{0}, .x = 0.0, .y = -SLOT_PITCH * 2 });
+    layout.dock = addNode(Node{ .id = "dock", .type = NodeType::LoadingBay, .maxRobots = 2,
+                                .data = LoadingDock{}, .x = (aisles - 1) * AISLE_SPACING, .y = -SLOT_PITCH * 2 });
+    addEdge(layout.frontDesk, 0, SLOT_PITCH * 2, false);
+    addEdge(layout.dock, aisles - 1, SLOT_PITCH * 2, false);
+
+    for (int row = 0; row < depth; ++row) {
+        if (isCrossRow(row)) continue;
+        for (int aisle = 0; aisle < aisles; ++aisle) {
+            layout.pickFaces.push_back(row * aisles + aisle);
+        }
+    }
+    std::stable_sort(layout.pickFaces.begin(), layout.pickFaces.end(), [&](int a, int b) {
+        return nodes[a].x + nodes[a].y < nodes[b].x + nodes[b].y;
+    });
+    return layout;
+}
+
+#endif
@@ -0,0 +1,139 @@
+// Compares the calendar event queue (calendarQueue.hpp) with the binary
+// heap it replaced (std::priority_queue<SimEvent>) on the classic "hold"
+// workload: pop the earliest event and schedule a follow-up, with a
+// steady number of pending events.
+//
+// Workloads:
+//   poisson  follow-up after an exponential delay (order/delivery arrivals)
+//   retry    whole-second times; a third of the events are retries after
+//            30 * 2^k s (k = 0..4) like the order backoff, so many share a time
+//
+// Usage: ./bench_events [pending ...]     (default: 100 10000 1000000)
+
+#include "../includes/eventSystem.hpp"
+#include "../includes/calendarQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace {
+
+using HeapQueue = std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>>;
+
+const long long HOLD_OPERATIONS = 2000000;
+const double MEAN_GAP = 30.0;     // Seconds between events, whatever the queue size
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+SimEvent makeEvent(double time, int sequence) {
+    SimEvent event;
+    event.setType(EventType::CustomerOrder);
+    event.setTriggerTime(time);
+    event.setNodeIndex(-1);
+    event.setProductID(sequence);
+    event.setQuantity(1);
+    return event;
+}
+
+// Follow-up delays, drawn up front so the timings are the queue alone
+std::vector<double> makeDelays(bool retryWorkload, long long count, double meanDelay) {
+    std::mt19937 rng(7);
+    std::exponential_distribution<double> arrival(1.0 / meanDelay);
+    std::uniform_int_distribution<int> kind(0, 2);
+    std::uniform_int_distribution<int> attempt(0, 4);
+
+    std::vector<double> delays(count);
+    for (double& delay : delays) {
+        if (!retryWorkload) {
+            delay = arrival(rng);
+        } else if (kind(rng) == 0) {
+            delay = 30.0 * std::pow(2.0, attempt(rng));
+        } else {
+            delay = std::ceil(arrival(rng));
+        }
+    }
+    return delays;
+}
+
+// Runs the hold workload on Q and returns ns per pop+push. 'order' gets
+// the pop sequence (time, product id) of the first pops for comparison.
+template <typename Q>
+double runHold(Q& queue, int pending, bool retryWorkload, const std::vector<double>& delays,
+               std::vector<std::pair<double, int>>& order) {
+    // Start from a plain arrival schedule; retries build up during the run
+    std::mt19937 rng(11);
+    std::exponential_distribution<double> arrival(1.0 / (MEAN_GAP * pending));
+    int sequence = 0;
+    for (int i = 0; i < pending; ++i) {
+        double time = arrival(rng);
+        queue.push(makeEvent(retryWorkload ? std::ceil(time) : time, sequence++));
+    }
+
+    order.clear();
+    auto start = std::chrono::steady_clock::now();
+    for (double delay : delays) {
+        SimEvent event = queue.top();
+        queue.pop();
+        if (order.size() < 100000) order.emplace_back(event.getTriggerTime(), event.getProductID());
+        queue.push(makeEvent(event.getTriggerTime() + delay, sequence++));
+    }
+    return elapsedMs(start) * 1e6 / static_cast<double>(delays.size());
+}
+
+void runSize(int pending) {
+    const char* workloads[] = {"poisson", "retry"};
+    for (int w = 0; w < 2; ++w) {
+        bool retryWorkload = w == 1;
+        std::vector<std::pair<double, int>> heapOrder;
+        std::vector<std::pair<double, int>> calendarOrder;
+
+        long long operations = std::max<long long>(HOLD_OPERATIONS, 4LL * pending);
+        std::vector<double> delays = makeDelays(retryWorkload, operations, MEAN_GAP * pending);
+
+        HeapQueue heap;
+        double heapNs = runHold(heap, pending, retryWorkload, delays, heapOrder);
+        CalendarQueue<SimEvent> calendar;
+        double calendarNs = runHold(calendar, pending, retryWorkload, delays, calendarOrder);
+
+        // Same times in the same order, and FIFO (rising ids) among equal times
+        bool same = heapOrder.size() == calendarOrder.size();
+        bool fifo = true;
+        for (size_t i = 0; same && i < heapOrder.size(); ++i) {
+            same = heapOrder[i].first == calendarOrder[i].first;
+            if (i > 0 && calendarOrder[i].first == calendarOrder[i - 1].first) {
+                fifo = fifo && calendarOrder[i].second > calendarOrder[i - 1].second;
+            }
+        }
+
+        std::printf("%9d  %-8s %10.1f %10.1f %8.2fx  %6zu %10.2f  %s\n", pending, workloads[w], heapNs,
+                    calendarNs, heapNs / calendarNs, calendar.getBucketCount(), calendar.getBucketWidth(),
+                    same && fifo ? "ok" : (same ? "NOT FIFO" : "MISMATCH"));
+        std::fflush(stdout);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {100, 10000, 1000000};
+    }
+
+    std::printf("%9s  %-8s %10s %10s %9s  %6s %10s\n", "pending", "workload", "heap ns", "calendar ns",
+                "speedup", "buckets", "width s");
+    for (int pending : sizes) {
+        if (pending > 0) runSize(pending);
+    }
+    return 0;
+}
@@ -0,0 +1,213 @@
+// Latency benchmark for the pathfinding entry points on generated
+// picking-aisle layouts (see generateAisleLayout in benchLayouts.hpp).
+//
+// Query mix, with pick faces near the front far more popular than the
+// back of the warehouse:
+//   40%  pick face -> front desk      (delivering an order)
+//   30%  dock      -> pick face       (restocking)
+//   30%  pick face -> pick face       (batch picking)
+// findShortestPathAvoiding additionally avoids the current positions of
+// AVOIDED_ROBOTS other robots (also drawn from the pick faces).
+//
+// One JSON object per line and operation on stdout:
+//   {"bench":"pathfinding","nodes":..,"edges":..,"op":"findPathAStar",
+//    "queries":..,"p50_us":..,"p99_us":..,"mean_us":..,"qps":..,
+//    "allocs_per_query":..,"bytes_per_query":..,"checksum":..}
+//
+// Usage: ./bench_pathfinding [nodes ...]     (default: 100 10000 100000 1000000)
+
+#include "benchLayouts.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/csrGraph.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <random>
+#include <vector>
+
+// Every heap allocation in the process goes through here so the
+// benchmark can report allocations per query
+static std::atomic<long long> allocationCount{0};
+static std::atomic<long long> allocatedBytes{0};
+
+// GCC sees free() on a pointer from operator new, which is exactly the point here
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+const int AVOIDED_ROBOTS = 8;
+const int MAX_QUERIES = 2000;
+const int MAX_SSSP_RUNS = 200;
+const int MIN_QUERIES = 10;
+const double TIME_LIMIT_MS = 2000.0;     // Per operation and layout
+
+struct Query {
+    int start;
+    int goal;
+    std::vector<int> avoid;
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+class QueryGenerator {
+public:
+    QueryGenerator(const AisleLayout& layout, unsigned seed) : layout(layout), rng(seed) {}
+
+    // Cubing a uniform sample puts about half of the picks in the front eighth
+    int pickFace() {
+        double u = unit(rng);
+        size_t index = static_cast<size_t>(u * u * u * layout.pickFaces.size());
+        return layout.pickFaces[std::min(index, layout.pickFaces.size() - 1)];
+    }
+
+    Query next() {
+        Query q;
+        double kind = unit(rng);
+        if (kind < 0.4) {
+            q = {pickFace(), layout.frontDesk, {}};
+        } else if (kind < 0.7) {
+            q = {layout.dock, pickFace(), {}};
+        } else {
+            q = {pickFace(), pickFace(), {}};
+        }
+        for (int i = 0; i < AVOIDED_ROBOTS; ++i) {
+            int node = pickFace();
+            if (node != q.start && node != q.goal) q.avoid.push_back(node);
+        }
+        return q;
+    }
+
+private:
+    const AisleLayout& layout;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> unit{0.0, 1.0};
+};
+
+// Time 'run' once per query (after one warm-up call) and print a result line
+void measure(const char* op, const std::vector<Query>& queries, int limit,
+             const std::function<double(const Query&)>& run) {
+    const CSRGraph& graph = getCSRGraph();
+    run(queries[0]);
+
+    std::vector<double> latencies;
+    latencies.reserve(limit);
+    double checksum = 0.0;
+    long long allocationsBefore = allocationCount.load();
+    long long bytesBefore = allocatedBytes.load();
+    auto started = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < limit; ++i) {
+        if (i >= MIN_QUERIES && elapsedMs(started) > TIME_LIMIT_MS) break;
+
+        const Query& q = queries[i % queries.size()];
+        auto start = std::chrono::steady_clock::now();
+        double value = run(q);
+        latencies.push_back(elapsedMs(start) * 1000.0);
+        if (value != std::numeric_limits<double>::infinity()) checksum += value;
+    }
+
+    double totalMs = elapsedMs(started);
+    long long allocations = allocationCount.load() - allocationsBefore;
+    long long bytes = allocatedBytes.load() - bytesBefore;
+    size_t count = latencies.size();
+
+    double mean = 0.0;
+    for (double l : latencies) mean += l;
+    mean /= static_cast<double>(count);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(std::ceil(p * count)) - 1;
+        return latencies[std::min(index, count - 1)];
+    };
+
+    std::printf("{\"bench\":\"pathfinding\",\"nodes\":%d,\"edges\":%d,\"op\":\"%s\",\"queries\":%zu,"
+                "\"p50_us\":%.2f,\"p99_us\":%.2f,\"mean_us\":%.2f,\"qps\":%.1f,"
+                "\"allocs_per_query\":%.2f,\"bytes_per_query\":%.0f,\"checksum\":%.3f}\n",
+                graph.nodeCount, graph.getEdgeCount(), op, count,
+                percentile(0.5), percentile(0.99), mean, count / (totalMs / 1000.0),
+                static_cast<double>(allocations) / count, static_cast<double>(bytes) / count, checksum);
+    std::fflush(stdout);
+}
+
+void runLayout(int targetNodes) {
+    // Aisles four times as deep as the warehouse is wide
+    int aisles = std::max(2, static_cast<int>(std::lround(std::sqrt(targetNodes / 4.0))));
+    int depth = std::max(3, targetNodes / aisles);
+    AisleLayout layout = generateAisleLayout(aisles, depth, 1234);
+    getCSRGraph();
+
+    QueryGenerator generator(layout, 42);
+    std::vector<Query> queries(MAX_QUERIES);
+    for (Query& q : queries) q = generator.next();
+
+    std::vector<double> distances;
+
+    measure("findShortestPath", queries, MAX_QUERIES, [](const Query& q) {
+        return findShortestPath(q.start, q.goal).totalDistance;
+    });
+    measure("findPathAStar", queries, MAX_QUERIES, [](const Query& q) {
+        return findPathAStar(q.start, q.goal).totalDistance;
+    });
+    measure("findShortestPathAvoiding", queries, MAX_QUERIES, [](const Query& q) {
+        return findShortestPathAvoiding(q.start, q.goal, q.avoid).totalDistance;
+    });
+    measure("dijkstraDistances", queries, MAX_SSSP_RUNS, [&](const Query& q) {
+        dijkstraDistances(q.start, distances);
+        return distances[q.goal];
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atoi(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes = {100, 10000, 100000, 1000000};
+    }
+
+    for (int size : sizes) {
+        if (size >= 12) runLayout(size);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Compares the Dijkstra queue backends (see QueueBackend in pathfinding.hpp)
+// on generated grid layouts.
+//
+// Usage: ./bench_queues [side ...]     (default: 100 316 1000)
+
+#include "benchLayouts.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/csrGraph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct BackendInfo {
+    QueueBackend backend;
+    const char* name;
+};
+
+const BackendInfo BACKENDS[] = {
+    {QueueBackend::BinaryHeap, "binary"},
+    {QueueBackend::DaryHeap, "4-ary"},
+    {QueueBackend::RadixHeap, "radix"},
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void runLayout(int side) {
+    generateGridLayout(side, side, 1234);
+    const CSRGraph& graph = getCSRGraph();
+    int n = graph.nodeCount;
+
+    // Fewer full single-source runs on the big layouts
+    int ssspRuns = std::max(2, 2000000 / n);
+    int p2pRuns = 200;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<int> sources(ssspRuns);
+    std::vector<std::pair<int, int>> pairs(p2pRuns);
+    for (int& s : sources) s = pick(rng);
+    for (auto& p : pairs) p = {pick(rng), pick(rng)};
+
+    std::vector<double> distances;
+    double referenceChecksum = -1.0;
+
+    for (const BackendInfo& info : BACKENDS) {
+        setQueueBackend(info.backend);
+
+        // Warm-up so the workspace has grown to the graph size
+        dijkstraDistances(sources[0], distances);
+
+        auto start = std::chrono::steady_clock::now();
+        double checksum = 0.0;
+        for (int s : sources) {
+            dijkstraDistances(s, distances);
+            checksum += distances[(s + n / 2) % n];
+        }
+        double ssspMs = elapsedMs(start) / ssspRuns;
+
+        start = std::chrono::steady_clock::now();
+        for (const auto& [from, to] : pairs) {
+            checksum += findShortestPath(from, to).totalDistance;
+        }
+        double p2pMs = elapsedMs(start) / p2pRuns;
+
+        // Every backend must produce the same distances
+        bool same = referenceChecksum < 0.0 || checksum == referenceChecksum;
+        if (referenceChecksum < 0.0) referenceChecksum = checksum;
+
+        std::printf("%-12s %9d %9d  %-8s %10.3f %10.3f  %s\n",
+                    (std::to_string(side) + "x" + std::to_string(side)).c_str(), n, graph.getEdgeCount(),
+                    info.name, ssspMs, p2pMs, same ? "ok" : "MISMATCH");
+        std::fflush(stdout);
+    }
+
+    setQueueBackend(QueueBackend::BinaryHeap);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sides;
+    for (int i = 1; i < argc; ++i) {
+        sides.push_back(std::atoi(argv[i]));
+    }
+    if (sides.empty()) {
+        sides = {100, 316, 1000};
+    }
+
+    std::printf("%-12s %9s %9s  %-8s %10s %10s\n", "layout", "nodes", "edges", "queue", "sssp ms", "p2p ms");
+    for (int side : sides) {
+        if (side >= 2) runLayout(side);
+    }
+    return 0;
+}
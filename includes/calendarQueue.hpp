@@ -0,0 +1,379 @@
+#ifndef CALENDARQUEUE_HPP
+#define CALENDARQUEUE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Refers to one scheduled entry of a CalendarQueue. It goes stale when the
+// entry is popped or cancelled (the slot's generation moves on), so an old
+// handle can never hit an entry scheduled later in the same slot.
+struct QueueHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isSet() const { return slot != UINT32_MAX; }
+};
+
+// Calendar queue (Brown 1988) for simulation events. Time is cut into
+// windows of 'width' seconds and window w lives in bucket w % bucketCount,
+// so a push is a short insert into one bucket and a pop only looks at the
+// bucket of the current window. The bucket count doubles/halves with the
+// queue size and the width is re-estimated from the spacing of the
+// earliest events, which keeps both O(1) amortized. If the event mix
+// drifts so far that pops get expensive, the queue recalibrates.
+//
+// Events with the same trigger time come out in the order they were
+// pushed (FIFO), so runs are deterministic.
+//
+// schedule() returns a handle for cancel() and reschedule(). An entry is
+// found again from its (time, sequence) key: bucket by time, then a binary
+// search inside it, so nothing stale is left behind to be popped later.
+//
+// T needs getTriggerTime() (and setTriggerTime() for reschedule()). The
+// rest of the interface mirrors std::priority_queue.
+template <typename T>
+class CalendarQueue {
+private:
+    struct Entry {
+        T item;
+        double time;
+        unsigned long long sequence;
+        uint32_t slot;
+
+        bool before(const Entry& other) const {
+            return time < other.time || (time == other.time && sequence < other.sequence);
+        }
+    };
+
+    // Entries of one bucket in time order. Popping advances 'head' instead
+    // of shifting, so same-time bursts stay O(1) per push and pop.
+    struct Bucket {
+        std::vector<Entry> entries;
+        size_t head = 0;
+
+        bool empty() const { return head == entries.size(); }
+        const Entry& front() const { return entries[head]; }
+
+        // Returns how many entries had to be shifted
+        size_t insert(Entry&& entry) {
+            auto pos = std::upper_bound(entries.begin() + head, entries.end(), entry,
+                                        [](const Entry& a, const Entry& b) { return a.before(b); });
+            if (pos == entries.begin() + head && head > 0) {
+                entries[--head] = std::move(entry);
+                return 0;
+            }
+            size_t shifted = static_cast<size_t>(entries.end() - pos);
+            entries.insert(pos, std::move(entry));
+            return shifted;
+        }
+
+        // Position of the entry with this key, or entries.size()
+        size_t find(double time, unsigned long long sequence) const {
+            auto pos = std::lower_bound(entries.begin() + head, entries.end(), std::make_pair(time, sequence),
+                                        [](const Entry& a, const std::pair<double, unsigned long long>& key) {
+                                            return a.time < key.first || (a.time == key.first && a.sequence < key.second);
+                                        });
+            if (pos == entries.end() || pos->time != time || pos->sequence != sequence) return entries.size();
+            return static_cast<size_t>(pos - entries.begin());
+        }
+
+        Entry take(size_t pos) {
+            Entry entry = std::move(entries[pos]);
+            if (pos == head) {
+                popFront();
+            } else {
+                entries.erase(entries.begin() + pos);
+            }
+            return entry;
+        }
+
+        void popFront() {
+            if (++head == entries.size()) {
+                entries.clear();
+                head = 0;
+            } else if (head >= 32 && head * 2 >= entries.size()) {
+                entries.erase(entries.begin(), entries.begin() + head);
+                head = 0;
+            }
+        }
+    };
+
+    static constexpr size_t MIN_BUCKETS = 16;
+    static constexpr size_t WIDTH_SAMPLE = 64;
+    static constexpr size_t MIN_DISTINCT_TIMES = 16;
+    static constexpr size_t CHECK_INTERVAL = 4096;   // Pops between cost checks (at least size())
+    static constexpr long long MAX_COST_PER_POP = 16;
+
+    // Key of the entry each handle slot points at
+    struct SlotInfo {
+        double time = 0.0;
+        unsigned long long sequence = 0;
+        uint32_t generation = 0;
+        bool live = false;
+    };
+
+    std::vector<Bucket> buckets;
+    std::vector<SlotInfo> slots;
+    std::vector<uint32_t> freeSlots;
+    size_t mask = MIN_BUCKETS - 1;
+    double width = 60.0;
+    double inverseWidth = 1.0 / 60.0;
+    size_t count = 0;
+    unsigned long long nextSequence = 0;
+
+    // Window of the earliest entry when cursorValid, otherwise a window
+    // no later than it (top() walks forward from there)
+    mutable long long cursorWindow = 0;
+    mutable bool cursorValid = false;
+
+    // Buckets stepped over in seek() and entries shifted by inserts since
+    // the last check. When the width no longer fits the events near the
+    // front (the mix changed), the queue is rebuilt with a new estimate.
+    mutable long long workSinceCheck = 0;
+    size_t popsSinceCheck = 0;
+
+    // Stats
+    mutable long long directSearches = 0;
+    long long resizes = 0;
+
+    long long windowOf(double time) const {
+        return static_cast<long long>(std::floor(time * inverseWidth));
+    }
+
+    Bucket& bucketOf(long long window) {
+        return buckets[static_cast<size_t>(window) & mask];
+    }
+
+    const Bucket& bucketOf(long long window) const {
+        return buckets[static_cast<size_t>(window) & mask];
+    }
+
+    // Move the cursor to the window of the earliest entry. Usually the next
+    // few buckets hold it; after a long quiet stretch fall back to a scan.
+    void seek() const {
+        if (cursorValid || count == 0) return;
+
+        for (size_t step = 0; step <= mask; ++step, ++cursorWindow, ++workSinceCheck) {
+            const Bucket& bucket = bucketOf(cursorWindow);
+            if (!bucket.empty() && windowOf(bucket.front().time) == cursorWindow) {
+                cursorValid = true;
+                return;
+            }
+        }
+
+        ++directSearches;
+        workSinceCheck += static_cast<long long>(buckets.size());
+        const Entry* earliest = nullptr;
+        for (const Bucket& bucket : buckets) {
+            if (!bucket.empty() && (!earliest || bucket.front().before(*earliest))) {
+                earliest = &bucket.front();
+            }
+        }
+        cursorWindow = windowOf(earliest->time);
+        cursorValid = true;
+    }
+
+    // Brown's estimate: 3 x the mean gap between the earliest events, which
+    // is where the dequeues happen. Gaps are taken between distinct times -
+    // a burst at one instant lands in one bucket whatever the width - and
+    // the sample grows until it spans enough of them.
+    double estimateWidth(std::vector<double>& times) const {
+        // Small queues thin out quickly past the front, so sample less of them
+        size_t sample = std::min(times.size(), std::max(MIN_DISTINCT_TIMES, std::min(WIDTH_SAMPLE, times.size() / 8)));
+        while (sample >= 2) {
+            std::nth_element(times.begin(), times.begin() + (sample - 1), times.end());
+            std::sort(times.begin(), times.begin() + sample);
+            size_t distinct = static_cast<size_t>(std::unique(times.begin(), times.begin() + sample) - times.begin());
+            if (distinct >= MIN_DISTINCT_TIMES || (sample == times.size() && distinct >= 2)) {
+                return 3.0 * (times[distinct - 1] - times[0]) / static_cast<double>(distinct - 1);
+            }
+            if (sample == times.size()) break;
+            sample = std::min(times.size(), sample * 4);
+        }
+        return width;
+    }
+
+    uint32_t acquireSlot() {
+        if (freeSlots.empty()) {
+            slots.emplace_back();
+            return static_cast<uint32_t>(slots.size() - 1);
+        }
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    void releaseSlot(uint32_t slot) {
+        slots[slot].live = false;
+        slots[slot].generation++;
+        freeSlots.push_back(slot);
+    }
+
+    bool isLive(QueueHandle handle) const {
+        return handle.slot < slots.size() && slots[handle.slot].live &&
+               slots[handle.slot].generation == handle.generation;
+    }
+
+    // Insert an entry whose slot is already set up
+    void insert(Entry&& entry) {
+        long long window = windowOf(entry.time);
+        SlotInfo& info = slots[entry.slot];
+        info.time = entry.time;
+        info.sequence = entry.sequence;
+        info.live = true;
+        workSinceCheck += static_cast<long long>(bucketOf(window).insert(std::move(entry)));
+        ++count;
+
+        // The cursor is never past the earliest entry; an event before it
+        // becomes the earliest
+        if (count == 1 || window < cursorWindow) {
+            cursorWindow = window;
+            cursorValid = true;
+        }
+        if (count > 2 * buckets.size()) resize(buckets.size() * 2);
+    }
+
+    // Take the entry of a live handle out of its bucket
+    Entry extract(QueueHandle handle) {
+        const SlotInfo& info = slots[handle.slot];
+        Bucket& bucket = bucketOf(windowOf(info.time));
+        Entry entry = bucket.take(bucket.find(info.time, info.sequence));
+        --count;
+
+        // The earliest entry may be gone; the cursor stays a lower bound
+        cursorValid = false;
+        return entry;
+    }
+
+    void shrinkIfSparse() {
+        if (buckets.size() > MIN_BUCKETS && count < buckets.size() / 2) {
+            resize(buckets.size() / 2);
+        }
+    }
+
+    void resize(size_t bucketCount) {
+        std::vector<Entry> all;
+        std::vector<double> times;
+        all.reserve(count);
+        times.reserve(count);
+        for (Bucket& bucket : buckets) {
+            for (size_t i = bucket.head; i < bucket.entries.size(); ++i) {
+                times.push_back(bucket.entries[i].time);
+                all.push_back(std::move(bucket.entries[i]));
+            }
+            bucket.entries.clear();
+            bucket.head = 0;
+        }
+
+        width = estimateWidth(times);
+        inverseWidth = 1.0 / width;
+        buckets.resize(bucketCount);
+        mask = bucketCount - 1;
+
+        // Re-adding in time order keeps every insert an append
+        std::sort(all.begin(), all.end(), [](const Entry& a, const Entry& b) { return a.before(b); });
+        for (Entry& entry : all) bucketOf(windowOf(entry.time)).entries.push_back(std::move(entry));
+
+        cursorValid = !all.empty();
+        cursorWindow = all.empty() ? 0 : windowOf(all[0].time);
+        workSinceCheck = 0;
+        popsSinceCheck = 0;
+        ++resizes;
+    }
+
+public:
+    CalendarQueue() : buckets(MIN_BUCKETS) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    void push(const T& item) {
+        schedule(item);
+    }
+
+    QueueHandle schedule(const T& item) {
+        uint32_t slot = acquireSlot();
+        insert(Entry{item, item.getTriggerTime(), nextSequence++, slot});
+        return QueueHandle{slot, slots[slot].generation};
+    }
+
+    // True while the entry is still queued
+    bool isPending(QueueHandle handle) const {
+        return isLive(handle);
+    }
+
+    // Remove a queued entry. Returns false for a stale handle.
+    bool cancel(QueueHandle handle) {
+        if (!isLive(handle)) return false;
+        Entry entry = extract(handle);
+        releaseSlot(entry.slot);
+        shrinkIfSparse();
+        return true;
+    }
+
+    // Move a queued entry to 'time'. It goes behind entries already queued
+    // at that time, as if newly scheduled; the handle stays valid.
+    bool reschedule(QueueHandle handle, double time) {
+        if (!isLive(handle)) return false;
+        Entry entry = extract(handle);
+        entry.item.setTriggerTime(time);
+        entry.time = time;
+        entry.sequence = nextSequence++;
+        insert(std::move(entry));
+        return true;
+    }
+
+    // Entry of a live handle (check isPending() first)
+    const T& get(QueueHandle handle) const {
+        const SlotInfo& info = slots[handle.slot];
+        const Bucket& bucket = bucketOf(windowOf(info.time));
+        return bucket.entries[bucket.find(info.time, info.sequence)].item;
+    }
+
+    // Earliest event (first pushed among equal times). Queue must not be empty.
+    const T& top() const {
+        seek();
+        return bucketOf(cursorWindow).front().item;
+    }
+
+    void pop() {
+        seek();
+        Bucket& bucket = bucketOf(cursorWindow);
+        releaseSlot(bucket.front().slot);
+        bucket.popFront();
+        --count;
+        cursorValid = false;
+        if (buckets.size() > MIN_BUCKETS && count < buckets.size() / 2) {
+            resize(buckets.size() / 2);
+        } else if (++popsSinceCheck >= std::max(CHECK_INTERVAL, count)) {
+            if (workSinceCheck > MAX_COST_PER_POP * static_cast<long long>(popsSinceCheck)) {
+                resize(buckets.size());
+            }
+            workSinceCheck = 0;
+            popsSinceCheck = 0;
+        }
+    }
+
+    void clear() {
+        for (Bucket& bucket : buckets) {
+            for (size_t i = bucket.head; i < bucket.entries.size(); ++i) releaseSlot(bucket.entries[i].slot);
+            bucket.entries.clear();
+            bucket.head = 0;
+        }
+        count = 0;
+        cursorValid = false;
+        cursorWindow = 0;
+    }
+
+    // Getters (stats)
+    size_t getBucketCount() const { return buckets.size(); }
+    double getBucketWidth() const { return width; }
+    long long getDirectSearches() const { return directSearches; }
+    long long getResizes() const { return resizes; }
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CBSPLANNER_HPP
+#define CBSPLANNER_HPP
+
+#include "datatypes.hpp"
+#include "reservationTable.hpp"
+#include "spaceTimePlanner.hpp"
+#include <vector>
+
+// Default wall-clock budget for one planning call. Large fleets that do not
+// converge in time fall back to prioritized planning.
+const double CBS_DEFAULT_TIME_BUDGET_MS = 50.0;
+const int CBS_DEFAULT_MAX_EXPANSIONS = 5000;
+
+// How often main replans the whole fleet when multi-robot planning is on
+const int CBS_REPLAN_INTERVAL = 5;   // Seconds
+
+struct CBSConfig {
+    double timeBudgetMs = CBS_DEFAULT_TIME_BUDGET_MS;
+    int maxExpansions = CBS_DEFAULT_MAX_EXPANSIONS;
+    double horizon = DEFAULT_PLAN_HORIZON;
+
+    // ECBS: expand the conflict-tree node with the fewest conflicts among
+    // those within suboptimality * (lowest cost). 1.0 is plain CBS.
+    double suboptimality = 1.5;
+};
+
+// One timed path per planned robot. Robots whose path was not found stay
+// parked at their current node.
+struct MultiRobotPlan {
+    std::vector<int> robotIds;
+    std::vector<int> goals;
+    std::vector<TimedPath> paths;
+
+    bool usedFallback = false;      // Prioritized planning produced the paths
+    bool conflictFree = false;
+    int expandedNodes = 0;          // Conflict-tree nodes expanded
+    int lowLevelSearches = 0;
+    double planningMs = 0.0;
+    double sumOfCosts = 0.0;        // Sum of arrival times relative to startTime
+
+    // Getters
+    size_t getRobotCount() const { return robotIds.size(); }
+    int getFoundCount() const;
+};
+
+// Conflict-based search over the robots in robotIds (goal per robot in goals).
+// Respects Node::maxRobots and forbids swaps along an edge, with the same
+// semantics as findTimedPath. Robots not in the list are parked where they are.
+MultiRobotPlan planMultiRobotPaths(const std::vector<int>& robotIds, const std::vector<int>& goals,
+                                   double startTime, const CBSConfig& config = CBSConfig());
+
+// Plan every robot with a pending target: the end of its current path, or
+// Robot::targetNode when it has no path
+MultiRobotPlan planPendingRobots(double startTime, const CBSConfig& config = CBSConfig());
+
+// One robot at a time in the given order, each booked before the next plans
+MultiRobotPlan planPrioritized(const std::vector<int>& robotIds, const std::vector<int>& goals,
+                               double startTime, double horizon = DEFAULT_PLAN_HORIZON);
+
+// Rebuild 'table' from the plan (other robots parked) and hand the new paths
+// to the robots
+void applyMultiRobotPlan(const MultiRobotPlan& plan, ReservationTable& table, double startTime);
+
+// When enabled (together with space-time planning), main replans all robots
+// with pending targets every CBS_REPLAN_INTERVAL seconds
+void setMultiRobotPlanning(bool enabled);
+bool isMultiRobotPlanningEnabled();
+
+#endif
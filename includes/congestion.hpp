@@ -0,0 +1,63 @@
+#ifndef CONGESTION_HPP
+#define CONGESTION_HPP
+
+#include "datatypes.hpp"
+#include "csrGraph.hpp"
+#include <vector>
+
+// Edge cost = distance * (1 + penalty of the node the edge enters), where
+// penalty = ROBOT_WEIGHT * currentRobots / maxRobots
+//         + HEAT_WEIGHT * recent heatmap occupancy / maxRobots
+const double CONGESTION_ROBOT_WEIGHT = 1.0;
+const double CONGESTION_HEAT_WEIGHT = 0.5;
+const double CONGESTION_HEAT_DECAY = 0.9;       // Per simulation step
+const double CONGESTION_MIN_CHANGE = 0.01;      // Smaller penalty changes are ignored
+const int CONGESTION_MAX_TREES = 16;            // Cached goal trees (least recently used is dropped)
+
+// Shortest-path tree towards one goal under the congested weights.
+// dist[v] = cost from v to goal, nextEdge[v] = CSR edge v leaves along.
+struct CongestionTree {
+    int goal = -1;
+    unsigned long lastUsed = 0;
+    std::vector<double> dist;
+    std::vector<int> nextEdge;
+};
+
+struct CongestionModel {
+    unsigned long builtForVersion = 0;
+    bool initialized = false;
+    std::vector<double> nodePenalty;
+    std::vector<double> recentOccupancy;   // Decayed seconds of robot presence
+    std::vector<double> lastHeatTime;      // Heatmap totalTimeSpent seen last update
+    std::vector<double> weights;           // Congested weight per CSR edge
+    std::vector<CongestionTree> trees;
+    unsigned long useCounter = 0;
+
+    // Stats
+    long long treeBuilds = 0;
+    long long treeRepairs = 0;
+    long long repairSettled = 0;
+};
+
+extern CongestionModel congestionModel;
+
+// Pull Node::currentRobots and the logger heatmap, reweight the edges into
+// nodes whose penalty changed and repair the cached trees in place.
+// 'steps' > 1 folds that many steps into one update; the heatmap time added
+// since the last update is taken as spread evenly over them.
+void updateCongestion(int steps = 1);
+
+// Rescale edges patched in place by a runtime graph change and repair the
+// cached trees, if the model was current at previousVersion
+void applyEdgeChangesToCongestion(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion);
+
+double getCongestedEdgeWeight(int edgeId);
+
+// Cheapest path under congested weights (totalDistance is still the physical length)
+Path findCongestionAwarePath(int startNode, int goalNode);
+
+// When enabled, startRobotMovement routes around congestion
+void setCongestionAwareRouting(bool enabled);
+bool isCongestionAwareRoutingEnabled();
+
+#endif
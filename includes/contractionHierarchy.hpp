@@ -0,0 +1,59 @@
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "datatypes.hpp"
+#include <string>
+#include <vector>
+
+// Contraction hierarchy over the frozen CSR graph.
+// Nodes are contracted one by one (lowest rank first); every path through a
+// contracted node that has no shorter witness gets a shortcut edge. A query
+// then only walks edges towards higher rank, from both ends, and meets at the
+// top. Intended for very large layouts - the warehouse default does not need it.
+struct CHEdge {
+    int from;
+    int to;
+    double weight;
+    int firstChild;    // Shortcut = firstChild + secondChild, -1 for an original edge
+    int secondChild;
+};
+
+struct ContractionHierarchy {
+    int nodeCount = 0;
+    unsigned long builtForVersion = 0;
+    unsigned long long graphFingerprint = 0;
+    bool valid = false;
+    int originalEdgeCount = 0;
+    std::vector<int> rank;               // Contraction order of each node
+    std::vector<CHEdge> edges;           // Original edges followed by shortcuts
+
+    // Upward edges leaving u:  edges[upEdges[upOffsets[u] .. upOffsets[u + 1])], from == u
+    std::vector<int> upOffsets;
+    std::vector<int> upEdges;
+
+    // Downward edges entering v, walked backwards: edges[downEdges[...]], to == v
+    std::vector<int> downOffsets;
+    std::vector<int> downEdges;
+
+    // Getters
+    int getShortcutCount() const { return static_cast<int>(edges.size()) - originalEdgeCount; }
+    bool isShortcut(int edgeId) const { return edges[edgeId].firstChild >= 0; }
+};
+
+extern ContractionHierarchy contractionHierarchy;
+
+// Contract the current graph. threadCount 0 = hardware concurrency
+void buildContractionHierarchy(unsigned int threadCount = 0);
+
+// True if the index exists and matches graphVersion
+bool isContractionHierarchyValid();
+
+// Bidirectional upward query. Returns the same Path as findShortestPath
+// (unpacked to original nodes); falls back to it when the index is stale.
+Path findShortestPathCH(int startNode, int endNode);
+
+// Persist / restore the index. load fails if the file belongs to another graph
+bool saveContractionHierarchy(const std::string& filename);
+bool loadContractionHierarchy(const std::string& filename);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include "datatypes.hpp"
+#include <vector>
+
+// Frozen compressed sparse row copy of adj, used by all searches.
+// Outgoing edges of node u are targets/weights[offsets[u] .. offsets[u + 1]).
+// Incoming edges of node v are revSources/revWeights[revOffsets[v] .. revOffsets[v + 1]).
+struct CSRGraph {
+    int nodeCount = 0;
+    unsigned long builtForVersion = 0;
+    bool built = false;
+    std::vector<int> offsets;      // nodeCount + 1 entries
+    std::vector<int> targets;
+    std::vector<double> weights;
+
+    // Reverse graph (for backward searches)
+    std::vector<int> revOffsets;
+    std::vector<int> revSources;
+    std::vector<double> revWeights;
+    std::vector<int> revEdgeIds;   // Index of the matching forward edge
+
+    // Largest factor k with k * straightLine(u, v) <= weight(u, v) on every edge,
+    // so k * Euclidean distance is an admissible A* heuristic for any layout
+    double coordinateScale = 1.0;
+
+    // Smallest edge weight (0 for an edgeless graph), e.g. for fixed-point queues.
+    // Only a lower bound once weights have been patched at runtime.
+    double minWeight = 0.0;
+
+    // Getters
+    int getEdgeBegin(int u) const { return offsets[u]; }
+    int getEdgeEnd(int u) const { return offsets[u + 1]; }
+    int getOutDegree(int u) const { return offsets[u + 1] - offsets[u]; }
+    int getEdgeCount() const { return static_cast<int>(targets.size()); }
+    int getRevEdgeBegin(int v) const { return revOffsets[v]; }
+    int getRevEdgeEnd(int v) const { return revOffsets[v + 1]; }
+};
+
+extern CSRGraph csrGraph;
+
+// One CSR edge whose weight was patched in place by a runtime graph change
+// (see graphMutation.hpp). The target is targets[edge].
+struct EdgeWeightChange {
+    int from;
+    int edge;
+    double oldWeight;
+    double newWeight;
+};
+
+// Weight a search should use: infinity while the edge is blocked or either end is disabled
+double getEffectiveWeight(int fromNode, const Edge& edge);
+
+// Cheapest of the (possibly parallel) CSR edges from -> to: its edge index
+// (-1 if there is none) and its current weight (infinity if there is none)
+int lightestEdge(const CSRGraph& graph, int from, int to);
+double lightestEdgeWeight(const CSRGraph& graph, int from, int to);
+
+// Freeze adj into CSR form. Called at the end of initGraphLayout()
+void buildCSRGraph();
+
+// Current CSR graph, rebuilt first if graphVersion has changed
+const CSRGraph& getCSRGraph();
+
+// Hash of the graph structure and weights, used to validate persisted tables
+unsigned long long computeGraphFingerprint(const CSRGraph& graph);
+
+#endif
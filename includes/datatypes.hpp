@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <variant>
+#include <memory>
 
 #define MAX_SLOTS 10
 
@@ -41,6 +42,7 @@ struct Edge {
     int to; 
     bool directed;
     double distance;
+    bool blocked = false;   // Closed at runtime (see graphMutation.hpp)
 };
 
 struct Product {
@@ -73,6 +75,10 @@ struct Slot {
     void setCapacity(int cap) { capacity = cap; }
 };
 
+// Bumped whenever a slot gets a new product (or the slot count changes)
+// so the product -> slot index knows when to rebuild
+extern unsigned long slotLayoutVersion;
+
 struct Shelf {
     std::string name;
     struct Slot slots[MAX_SLOTS];
@@ -104,9 +110,11 @@ struct Shelf {
         if (count < 0) count = 0;
         if (count > MAX_SLOTS) count = MAX_SLOTS;
         slotCount = count;
+        slotLayoutVersion++;
     }
     void setSlot(int index, const Slot& slot) {
         if (index >= 0 && index < slotCount && index < MAX_SLOTS) {
+            if (slots[index].productID != slot.productID) slotLayoutVersion++;
             slots[index] = slot;
         }
     }
@@ -163,17 +171,24 @@ struct Node {
     int currentRobots = 0;
     std::variant<Shelf, LoadingDock, ChargingStation, FrontDesk> data;
     Zone zone = Zone::Other;
-    
+    double x = 0.0;        // Layout position (same unit as Edge::distance)
+    double y = 0.0;
+    bool disabled = false;   // No edge into or out of it may be used
+
     // Getters
     std::string getId() const { return id; }
     NodeType getType() const { return type; }
     int getMaxRobots() const { return maxRobots; }
     int getCurrentRobots() const { return currentRobots; }
     Zone getZone() const { return zone; }
-    
+    double getX() const { return x; }
+    double getY() const { return y; }
+    bool isDisabled() const { return disabled; }
+
     // Setters
     void setCurrentRobots(int robots) { currentRobots = robots; }
     void setZone(Zone z) { zone = z; }
+    void setPosition(double newX, double newY) { x = newX; y = newY; }
     
     // Variant helpers
     bool isShelf() const { return std::holds_alternative<Shelf>(data); }
@@ -321,7 +336,7 @@ struct Robot {
     double battery;
     double speed;
     Order currentOrder;
-    Path currentPath;
+    std::shared_ptr<const Path> currentPath;   // Shared with the path cache, may be null
     
     // Getters
     std::string getId() const { return id; }
@@ -337,6 +352,7 @@ struct Robot {
     double getSpeed() const { return speed; }
     const Order& getCurrentOrder() const { return currentOrder; }
     Order& getCurrentOrderMutable() { return currentOrder; }
+    const Path* getCurrentPath() const { return currentPath.get(); }
     
     // Setters
     void setId(const std::string& newId) { id = newId; }
@@ -392,6 +408,9 @@ extern std::vector<Node> nodes;
 extern std::vector<std::vector<Edge>> adj;
 extern std::vector<Product> products;
 
+// Bumped on every graph change so derived structures know when to rebuild
+extern unsigned long graphVersion;
+
 extern int loadingDockNode;
 extern int shelfANode;
 extern int shelfBNode;
@@ -0,0 +1,32 @@
+#ifndef DISTANCEBATCH_HPP
+#define DISTANCEBATCH_HPP
+
+#include "datatypes.hpp"
+#include <vector>
+
+// Result of a many-to-many query, row per source and column per target
+struct DistanceBatch {
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<double> dist;      // dist[i * targets.size() + j] = d(sources[i], targets[j])
+    std::vector<Path> paths;       // Same layout, empty unless paths were requested
+
+    // Getters
+    double getDistance(int i, int j) const { return dist[static_cast<size_t>(i) * targets.size() + j]; }
+    const Path& getPath(int i, int j) const { return paths[static_cast<size_t>(i) * targets.size() + j]; }
+    bool hasPaths() const { return !paths.empty(); }
+};
+
+// Distances (and optionally paths) from every source to every target.
+// Uses the all-pairs table when it is current. Otherwise runs one
+// multi-target search per source, or one reverse search per target when
+// there are fewer targets, spread over the shared thread pool.
+// Unreachable or invalid pairs get infinity and a not-found path.
+DistanceBatch computeDistanceBatch(const std::vector<int>& sources, const std::vector<int>& targets,
+                                   bool withPaths = false);
+
+// Shorthands for the common one-to-many / many-to-one cases
+std::vector<double> oneToManyDistances(int source, const std::vector<int>& targets);
+std::vector<double> manyToOneDistances(const std::vector<int>& sources, int target);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef DISTANCEMATRIX_HPP
+#define DISTANCEMATRIX_HPP
+
+#include "datatypes.hpp"
+#include "csrGraph.hpp"
+#include <vector>
+
+// Above this node count the n*n table gets too big and queries fall back to Dijkstra
+const int ALL_PAIRS_MAX_NODES = 2048;
+
+// All-pairs distance and next-hop table
+struct DistanceMatrix {
+    int nodeCount = 0;
+    unsigned long builtForVersion = 0;
+    bool valid = false;
+    std::vector<double> dist;      // dist[from * nodeCount + to]
+    std::vector<int> nextHop;      // First node after 'from' on the shortest path, -1 if unreachable
+
+    double getDistance(int from, int to) const { return dist[static_cast<size_t>(from) * nodeCount + to]; }
+    int getNextHop(int from, int to) const { return nextHop[static_cast<size_t>(from) * nodeCount + to]; }
+};
+
+extern DistanceMatrix distanceMatrix;
+
+// Build the table (one Dijkstra per source). Call after initGraphLayout()
+void buildDistanceMatrix();
+
+// Rebuild if graphVersion changed since last build. Returns false if the graph is too large
+bool ensureDistanceMatrix();
+
+// True if the table is built and matches the current graph (never triggers a rebuild)
+bool isDistanceMatrixCurrent();
+
+// Bring a table that was current at previousVersion up to date with edges
+// patched in place: cheaper edges are merged in O(n^2) each, and only the
+// rows in which a dearer edge lay on a shortest path are recomputed
+void applyEdgeChangesToDistanceMatrix(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion);
+
+// O(1) lookups (fall back to bidirectional Dijkstra if the table is unavailable)
+double getCachedDistance(int fromNode, int toNode);
+int getNextHop(int fromNode, int toNode);
+
+// Path built by walking the next-hop table
+Path getCachedPath(int fromNode, int toNode);
+
+#endif
@@ -3,7 +3,8 @@
 
 #include "datatypes.hpp"
 #include "robot.hpp"
-#include <queue>
+#include "calendarQueue.hpp"
+#include "timerWheel.hpp"
 #include <random>
 
 enum class EventType {
@@ -12,15 +13,24 @@ enum class EventType {
     RobotTaskComplete,
     LowBattery,
     RestockNeeded,
-    UrgentRestock
+    UrgentRestock,
+    OrderRetry          // Dispatch retry of an order that already arrived
 };
 
+// How long an out-of-stock order waits for a restock before it is cancelled
+const double BACKORDER_TIMEOUT = 1800.0;  // 30 min
+
+// Periodic jobs
+const double RESTOCK_CHECK_INTERVAL = 1800.0;  // 30 min
+const double BATTERY_CHECK_INTERVAL = 10.0;    // LOW_BATTERY reminder while an idle robot is low
+
 struct SimEvent {
     EventType type;
     double triggerTime;
     int nodeIndex;
     int productID;
     int quantity;
+    double deadline = -1.0;   // Task deadline carried over retries (-1 = none yet)
     
     // Getters
     EventType getType() const { return type; }
@@ -28,6 +38,7 @@ struct SimEvent {
     int getNodeIndex() const { return nodeIndex; }
     int getProductID() const { return productID; }
     int getQuantity() const { return quantity; }
+    double getDeadline() const { return deadline; }
     
     // Setters
     void setType(EventType t) { type = t; }
@@ -35,6 +46,7 @@ struct SimEvent {
     void setNodeIndex(int idx) { nodeIndex = idx; }
     void setProductID(int pid) { productID = pid; }
     void setQuantity(int qty) { quantity = qty; }
+    void setDeadline(double time) { deadline = time; }
     
     // Utility
     std::string getTypeString() const {
@@ -44,6 +56,8 @@ struct SimEvent {
             case EventType::RobotTaskComplete: return "RobotTaskComplete";
             case EventType::LowBattery: return "LowBattery";
             case EventType::RestockNeeded: return "RestockNeeded";
+            case EventType::UrgentRestock: return "UrgentRestock";
+            case EventType::OrderRetry: return "OrderRetry";
             default: return "Unknown";
         }
     }
@@ -53,8 +67,26 @@ struct SimEvent {
     }
 };
 
-// Global event queue (prioriterad efter tid)
-extern std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> eventQueue;
+// Periodic work and deadlines run on a timer wheel (1 s ticks) next to
+// the event queue, which is left to the irregular events
+enum class TimerType {
+    RestockSweep,
+    PopularityDecay,
+    BatteryCheck,        // target = robot index
+    BackorderDeadline    // target = product ID, tag = backorder serial
+};
+
+struct SimTimer {
+    TimerType type;
+    int target;
+    long long tag;
+};
+
+// Global event queue (prioriterad efter tid, FIFO vid samma tid).
+// eventQueue.schedule() returns a handle for cancel() and reschedule().
+using EventHandle = QueueHandle;
+extern CalendarQueue<SimEvent> eventQueue;
+extern TimerWheel<SimTimer> simTimers;
 extern std::mt19937 rng;
 extern double currentSimTime;
 
@@ -66,8 +98,17 @@ void scheduleRestockCheck(double currentTime);
 // Event handlers
 void handleIncomingDelivery(const SimEvent& event);
 void handleCustomerOrder(const SimEvent& event);
+void handleOrderRetry(const SimEvent& event);
 void handleRestockNeeded(const SimEvent& event);
 
+// Backorders: out-of-stock orders wait per product and are dispatched (in
+// arrival order) as soon as a restock or delivery makes them fit
+void releaseBackorders(int productID);
+
+// Report LOW_BATTERY for an idle robot now and every BATTERY_CHECK_INTERVAL
+// until it is charged or busy again (call when a robot stops)
+void startBatteryWatch(int robotIdx);
+
 // Initialize event system
 void initEventSystem(unsigned int seed = 42);
 void processEvents(double deltaTime);
@@ -77,8 +118,10 @@ namespace EventSystemAccess {
     double getCurrentSimTime();
     void setCurrentSimTime(double time);
     int getQueueSize();
+    int getBackorderCount();   // Orders waiting for a restock
     bool hasNextEvent();
     double getNextEventTime();
+    double getNextTimerTime();   // -1 when no timer is pending
     SimEvent peekNextEvent();  // Get next event without removing it
     
     // Statistics
@@ -86,6 +129,10 @@ namespace EventSystemAccess {
         int totalDeliveries;
         int totalOrders;
         int totalRestockChecks;
+        int totalBackorders;            // Orders that had to wait for stock
+        int totalBackordersReleased;
+        int totalBackordersCancelled;   // Deadline passed before a restock
+        int totalTasksExpired;          // Retries given up at the task deadline
         double avgDeliveryInterval;
         double avgOrderInterval;
         
@@ -93,6 +140,10 @@ namespace EventSystemAccess {
         int getTotalDeliveries() const { return totalDeliveries; }
         int getTotalOrders() const { return totalOrders; }
         int getTotalRestockChecks() const { return totalRestockChecks; }
+        int getTotalBackorders() const { return totalBackorders; }
+        int getTotalBackordersReleased() const { return totalBackordersReleased; }
+        int getTotalBackordersCancelled() const { return totalBackordersCancelled; }
+        int getTotalTasksExpired() const { return totalTasksExpired; }
         double getAvgDeliveryInterval() const { return avgDeliveryInterval; }
         double getAvgOrderInterval() const { return avgOrderInterval; }
     };
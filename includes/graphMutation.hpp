@@ -0,0 +1,40 @@
+#ifndef GRAPHMUTATION_HPP
+#define GRAPHMUTATION_HPP
+
+#include "datatypes.hpp"
+
+// Runtime layout changes: aisle closures, detours, changed lengths.
+//
+// Every call that changes an effective edge weight bumps graphVersion (the
+// graph epoch) once and patches the derived structures instead of
+// rebuilding them from scratch:
+//   - CSR arrays: weights patched in place, edge ids stay the same
+//   - all-pairs table: see applyEdgeChangesToDistanceMatrix()
+//   - landmark tables: see applyEdgeChangesToLandmarks()
+//   - congestion trees: repaired
+//   - path cache: only entries that cross a dearer edge are dropped (plus,
+//     for cheaper edges, those the all-pairs table shows are no longer shortest)
+//   - robots' currentPath: replanned when the rest of the route crosses a
+//     closed edge or disabled node
+//   - reservation table: kept
+// The contraction hierarchy cannot be patched and goes stale (CH queries
+// fall back to Dijkstra until it is rebuilt). addNode/addEdge still force
+// full rebuilds.
+//
+// Edges are named by their end nodes. For undirected edges both directions
+// change together; parallel edges all change.
+
+// Close / reopen an edge. False if there is no such edge
+bool blockEdge(int fromNode, int toNode);
+bool unblockEdge(int fromNode, int toNode);
+bool isEdgeBlocked(int fromNode, int toNode);
+
+// New length (> 0). False if there is no such edge or the length is invalid
+bool setEdgeWeight(int fromNode, int toNode, double distance);
+
+// A disabled node can't be entered or left (its edges keep their own state)
+bool disableNode(int node);
+bool enableNode(int node);
+bool isNodeDisabled(int node);
+
+#endif
@@ -12,6 +12,7 @@ void updatePopularityAndZone(int productID);
 void applyPopularityDecay(double currentTime);
 void setDecayInterval(double intervalSeconds);
 double getDecayInterval();
+double getNextDecayTime();   // Sim time at which the next decay is due
 void resetDecayTimer();
 
 // Zone utilities
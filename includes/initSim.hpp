@@ -3,6 +3,10 @@
 
 #include "datatypes.hpp"
 
+// Append to the graph (both bump graphVersion)
+int addNode(const Node& n);
+void addEdge(int from, int to, double distance, bool directed);
+
 void assignProductToSlot(Shelf& shelf, int slotIndex, int productID, int capacity, int occupied);
 void initGraphLayout();
 void resetInventory();
@@ -0,0 +1,36 @@
+#ifndef INVENTORYINDEX_HPP
+#define INVENTORYINDEX_HPP
+
+#include "datatypes.hpp"
+#include <vector>
+
+// One shelf slot holding a product
+struct SlotRef {
+    int node = -1;     // Shelf node index
+    int slot = -1;     // Slot index on that shelf
+
+    // Live stock of the slot
+    int getOccupied() const;
+};
+
+// Product ID -> the shelf slots assigned to it, in node and slot order (the
+// order the old full scans visited them). Stock is read from the slots
+// themselves, so setSlotOccupied() needs no bookkeeping; assigning a
+// product to a slot (Shelf::setSlot, assignProductToSlot) bumps
+// slotLayoutVersion and the index is rebuilt on the next query.
+const std::vector<SlotRef>& getProductSlots(int productID);
+
+// First slot holding at least 'quantity' units of the product
+bool findSlotWithStock(int productID, int quantity, SlotRef& out);
+
+// Slot with the most units of the product (first one on ties); false when
+// every slot of the product is empty
+bool findFullestSlot(int productID, SlotRef& out);
+
+// First slot on shelf 'node' assigned to the product (stocked or not)
+int findProductSlotOnShelf(int productID, int node);
+
+// Force a rebuild (normally automatic)
+void rebuildInventoryIndex();
+
+#endif
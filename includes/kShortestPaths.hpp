@@ -0,0 +1,40 @@
+#ifndef KSHORTESTPATHS_HPP
+#define KSHORTESTPATHS_HPP
+
+#include "datatypes.hpp"
+#include "pathCache.hpp"
+#include <vector>
+
+// Alternatives stay in the cache only while within this factor of the best route
+const double ALTERNATIVE_SLACK = 1.25;
+const size_t DEFAULT_ALTERNATIVE_CACHE_CAPACITY = 256;
+
+// Up to k loopless paths from start to goal, cheapest first (Yen's algorithm).
+// Paths differ in their node sequence; parallel edges don't count twice.
+std::vector<Path> findKShortestPaths(int startNode, int goalNode, int k);
+
+// Cached alternative set for one origin-destination pair
+struct PathAlternatives {
+    int start = -1;
+    int goal = -1;
+    int requestedK = 0;
+    std::vector<SharedPath> paths;   // Cheapest first, all within ALTERNATIVE_SLACK of paths[0]
+    unsigned long nextPick = 0;      // Round-robin position for pickAlternative()
+
+    // Getters
+    int getCount() const { return static_cast<int>(paths.size()); }
+    const SharedPath& getPath(int i) const { return paths[i]; }
+};
+
+// Cached set of up to k near-optimal alternatives, recomputed when a larger
+// k is asked for or the graph epoch has moved on. Returned as a copy (the
+// paths themselves are shared) since another thread may evict the entry.
+PathAlternatives getPathAlternatives(int startNode, int goalNode, int k);
+
+// Spread robots over the cached alternatives: each call hands out the next
+// one in turn (O(1) once the set is cached). Not-found path if unreachable.
+SharedPath pickAlternative(int startNode, int goalNode, int k = 3);
+
+void clearAlternativeCache();
+
+#endif
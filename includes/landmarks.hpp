@@ -0,0 +1,49 @@
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include "datatypes.hpp"
+#include "csrGraph.hpp"
+#include <string>
+#include <vector>
+
+// ALT (A*, Landmarks, Triangle inequality) preprocessing.
+// For each landmark L we store d(L, v) and d(v, L) for every node v, which
+// gives the lower bound d(v, t) >= max(d(L, t) - d(L, v), d(v, L) - d(t, L)).
+// Works on directed layouts without any node coordinates.
+struct LandmarkTable {
+    int nodeCount = 0;
+    int landmarkCount = 0;
+    unsigned long builtForVersion = 0;
+    bool valid = false;
+    std::vector<int> landmarks;
+    std::vector<double> fromLandmark;   // [k * nodeCount + v] = d(L_k, v)
+    std::vector<double> toLandmark;     // [k * nodeCount + v] = d(v, L_k)
+
+    // Getters
+    int getLandmarkCount() const { return landmarkCount; }
+    int getLandmark(int k) const { return landmarks[k]; }
+};
+
+extern LandmarkTable landmarkTable;
+
+// Pick 'count' landmarks (farthest-point selection) and compute both distance tables
+void buildLandmarks(int count = 8);
+
+// Rebuild with the previous landmark count if the graph changed. False if never built
+bool ensureLandmarks();
+
+// Keep a table that was current at previousVersion usable after edges were
+// patched in place. The bounds only need d(L, w) <= d(L, v) + weight(v, w) on
+// every edge (and the mirror image for d(v, L)), so cheaper edges are
+// propagated and dearer ones are left alone - the bounds just get looser
+// until the next buildLandmarks().
+void applyEdgeChangesToLandmarks(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion);
+
+// Triangle-inequality lower bound on d(node, target). Infinity if target is unreachable
+double landmarkLowerBound(int node, int target);
+
+// Persist / restore the tables. load fails if the file belongs to another graph
+bool saveLandmarks(const std::string& filename);
+bool loadLandmarks(const std::string& filename);
+
+#endif
@@ -96,6 +96,7 @@ public:
     // Utility
     void updateMetrics(const std::map<std::string, double>& stepResult);
     EpisodeMetrics getMetrics() const { return metrics; }
+    const std::vector<HeatmapData>& getHeatmapData() const { return heatmapData; }
     void clear();
 };
 
@@ -0,0 +1,48 @@
+#ifndef NEARESTQUERY_HPP
+#define NEARESTQUERY_HPP
+
+#include "datatypes.hpp"
+#include <functional>
+#include <limits>
+#include <vector>
+
+// Distance field towards one kind of facility: for every node, how far it
+// is to the closest node of that type and which node that is. Built with
+// one multi-source search, so it costs the same for one dock or fifty.
+struct FacilityField {
+    NodeType type = NodeType::Junction;
+    unsigned long builtForVersion = 0;
+    bool valid = false;
+    std::vector<double> dist;     // d(v, nearest facility), infinity if none reachable
+    std::vector<int> nearest;     // Facility node, -1 if none reachable
+
+    // Getters
+    double getDistance(int v) const { return dist[v]; }
+    int getNearest(int v) const { return nearest[v]; }
+};
+
+// Multi-source Dijkstra towards 'sources': outDist[v] = min over s of d(v, s),
+// outNearest[v] = the s that achieves it (lowest index on ties)
+void multiSourceDistances(const std::vector<int>& sources, std::vector<double>& outDist,
+                          std::vector<int>& outNearest);
+
+// Field for a facility type, rebuilt lazily when graphVersion changes
+const FacilityField& getFacilityField(NodeType type);
+
+// Closest facility of a type to 'node' (O(1) once the field exists), -1 if none
+int findNearestFacility(int node, NodeType type, double* outDistance = nullptr);
+
+// Closest charging station with a free port, one search bounded by
+// maxDistance (port occupancy changes too often for a precomputed field)
+int findNearestFreeCharger(int node, double maxDistance = std::numeric_limits<double>::infinity(),
+                           double* outDistance = nullptr);
+
+// Robot closest to 'node' (travel distance robot -> node) that 'eligible'
+// accepts and that is strictly closer than maxDistance. One search that
+// stops at the first ring containing an eligible robot; ties go to the
+// lowest robot index. -1 if there is none.
+int findNearestRobot(int node, const std::function<bool(int)>& eligible,
+                     double maxDistance = std::numeric_limits<double>::infinity(),
+                     double* outDistance = nullptr);
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef PATHCACHE_HPP
+#define PATHCACHE_HPP
+
+#include "datatypes.hpp"
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class PathConstraints;
+
+// Paths are shared read-only between the cache and every robot following them
+using SharedPath = std::shared_ptr<const Path>;
+
+const size_t DEFAULT_PATH_CACHE_CAPACITY = 1024;
+
+struct PathCacheKey {
+    int start;
+    int goal;
+    unsigned long long constraintHash;   // PathConstraints::getHash(), 0 = unconstrained
+    unsigned long epoch;                 // graphVersion the path was computed for
+
+    bool operator==(const PathCacheKey& other) const {
+        return start == other.start && goal == other.goal &&
+               constraintHash == other.constraintHash && epoch == other.epoch;
+    }
+};
+
+struct PathCacheKeyHash {
+    size_t operator()(const PathCacheKey& key) const {
+        size_t h = std::hash<unsigned long long>()(key.constraintHash);
+        h = h * 31 + std::hash<int>()(key.start);
+        h = h * 31 + std::hash<int>()(key.goal);
+        return h * 31 + std::hash<unsigned long>()(key.epoch);
+    }
+};
+
+// Bounded least-recently-used map from PathCacheKey to SharedPath.
+// Entries from an older graph epoch are dropped as soon as the epoch moves on.
+class PathCache {
+private:
+    struct Entry {
+        PathCacheKey key;
+        SharedPath path;
+    };
+
+    std::list<Entry> lru;   // Most recently used first
+    std::unordered_map<PathCacheKey, std::list<Entry>::iterator, PathCacheKeyHash> index;
+    size_t capacity;
+    unsigned long epoch = 0;
+    mutable std::mutex mutex;
+
+    // Stats
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+    unsigned long long evictions = 0;
+    unsigned long long invalidations = 0;
+
+    void checkEpoch();
+
+public:
+    explicit PathCache(size_t maxEntries = DEFAULT_PATH_CACHE_CAPACITY) : capacity(maxEntries) {}
+
+    // nullptr on a miss
+    SharedPath lookup(const PathCacheKey& key);
+    void insert(const PathCacheKey& key, SharedPath path);
+
+    void clear();
+    void setCapacity(size_t maxEntries);
+
+    // Carry entries from previousEpoch over to the current graphVersion,
+    // dropping the ones 'keep' rejects (everything, if the cache is older)
+    void revalidate(unsigned long previousEpoch,
+                    const std::function<bool(const PathCacheKey&, const Path&)>& keep);
+
+    // Getters
+    size_t getSize() const;
+    size_t getCapacity() const { return capacity; }
+    unsigned long long getHits() const { return hits; }
+    unsigned long long getMisses() const { return misses; }
+    unsigned long long getEvictions() const { return evictions; }
+    unsigned long long getInvalidations() const { return invalidations; }
+    double getHitRate() const {
+        unsigned long long total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+    }
+
+    void printStats() const;
+};
+
+extern PathCache pathCache;
+
+// Shortest path through the global cache (computed on a miss).
+// Not-found results are cached too, so unreachable goals stay cheap.
+SharedPath getSharedPath(int startNode, int goalNode);
+
+// Same for a constrained query. Constraints that depend on live state
+// (skip full nodes, custom filters) are computed fresh every time.
+SharedPath getSharedConstrainedPath(int startNode, int goalNode, const PathConstraints& constraints);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef PATHCONSTRAINTS_HPP
+#define PATHCONSTRAINTS_HPP
+
+#include "datatypes.hpp"
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <utility>
+
+// Growable bit set, one bit per node / edge id
+struct Bitset {
+    std::vector<uint64_t> words;
+    int count = 0;   // Number of set bits
+
+    bool test(int i) const {
+        size_t w = static_cast<size_t>(i) >> 6;
+        return w < words.size() && (words[w] >> (i & 63)) & 1;
+    }
+    void set(int i) {
+        size_t w = static_cast<size_t>(i) >> 6;
+        if (w >= words.size()) words.resize(w + 1, 0);
+        if (!test(i)) {
+            words[w] |= uint64_t(1) << (i & 63);
+            ++count;
+        }
+    }
+    void reset(int i) {
+        if (test(i)) {
+            words[static_cast<size_t>(i) >> 6] &= ~(uint64_t(1) << (i & 63));
+            --count;
+        }
+    }
+    void clear() {
+        std::fill(words.begin(), words.end(), 0);
+        count = 0;
+    }
+    bool any() const { return count > 0; }
+};
+
+// Filter for constrained path queries. Build it once and pass it to
+// findConstrainedPath() as often as needed - checks are O(1) per edge,
+// whatever the number of forbidden nodes.
+//
+// Every node on the path must be allowed, except that the capacity check
+// never applies to the start (the querying robot is usually standing there).
+class PathConstraints {
+private:
+    Bitset forbiddenNodes;
+    std::vector<std::pair<int, int>> forbiddenPairs; // (from, to) as given
+
+    // forbiddenPairs mapped to CSR edge ids for one graph version
+    mutable Bitset forbiddenEdges;
+    mutable unsigned long edgesForVersion = 0;
+    mutable bool edgesResolved = false;
+    bool skipFullNodes = false;
+    std::function<bool(int)> nodeFilter;
+    unsigned long filterId = 0;
+
+public:
+    void forbidNode(int node);
+    void forbidNodes(const std::vector<int>& nodeList);
+    void allowNode(int node);
+
+    // Forbid every edge from -> to (parallel edges included)
+    void forbidEdge(int fromNode, int toNode);
+
+    // Skip nodes where currentRobots >= maxRobots
+    void setSkipFullNodes(bool enabled) { skipFullNodes = enabled; }
+
+    // Extra predicate, return false to exclude a node. Give different
+    // predicates different ids so getHash() can tell them apart.
+    void setNodeFilter(std::function<bool(int)> filter, unsigned long id = 1);
+
+    void clear();
+
+    // Map forbidden edges to CSR ids for the current graph. Done lazily on
+    // first use; call it up front before sharing one instance across threads.
+    void resolveEdges() const;
+
+    bool isNodeAllowed(int node, bool isStart = false) const;
+    bool isEdgeAllowed(int edgeId) const;
+
+    // Getters
+    bool isEmpty() const;
+    bool getSkipFullNodes() const { return skipFullNodes; }
+    bool hasNodeFilter() const { return static_cast<bool>(nodeFilter); }
+    int getForbiddenNodeCount() const { return forbiddenNodes.count; }
+
+    // Hash of the constraint set (0 when empty), e.g. for caching query results
+    unsigned long long getHash() const;
+};
+
+#endif
@@ -5,18 +5,28 @@
 #include <vector>
 #include <limits>
 
-
+class PathConstraints;
 
 // Dijkstra's algorithm for shortest path
 Path findShortestPath(int startNode, int endNode);
 
+// Same result, searching from both ends (about half the settled nodes, no preprocessing)
+Path findShortestPathBidirectional(int startNode, int endNode);
+
 // Find path avoiding certain nodes (useful for avoiding congestion)
 Path findShortestPathAvoiding(int startNode, int endNode, const std::vector<int>& avoidNodes);
 
+// Shortest path that only uses nodes/edges allowed by 'constraints' (see pathConstraints.hpp)
+Path findConstrainedPath(int startNode, int endNode, const PathConstraints& constraints);
+
 // Find all shortest paths from a source (useful for pre-computation)
 std::vector<double> dijkstraDistances(int sourceNode);
 std::vector<int> dijkstraPredecessors(int sourceNode);
 
+// Same, but write into a caller-owned buffer (no allocation once it has grown)
+void dijkstraDistances(int sourceNode, std::vector<double>& outDistances);
+void dijkstraPredecessors(int sourceNode, std::vector<int>& outPredecessors);
+
 // Reconstruct path from predecessors
 Path reconstructPath(int startNode, int endNode, const std::vector<int>& predecessors, 
                     const std::vector<double>& distances);
@@ -27,10 +37,33 @@ bool hasEdge(int fromNode, int toNode);
 // Helper: Get edge distance
 double getEdgeDistance(int fromNode, int toNode);
 
-// A* variant (optional, for future optimization)
+// Lower bound used by A*. Landmarks needs buildLandmarks()/loadLandmarks()
+// first and falls back to Euclidean until a table exists.
+enum class HeuristicMode {
+    None,        // plain Dijkstra order
+    Euclidean,   // scaled straight-line distance from node coordinates
+    Landmarks    // ALT triangle bounds (max'ed with Euclidean)
+};
+
+void setHeuristicMode(HeuristicMode mode);
+HeuristicMode getHeuristicMode();
+
+// Priority queue used by plain Dijkstra (findShortestPath, dijkstraDistances/
+// dijkstraPredecessors and everything built on them)
+enum class QueueBackend {
+    BinaryHeap,   // std heap with lazy deletion
+    DaryHeap,     // indexed 4-ary heap with decrease-key
+    RadixHeap     // radix heap on fixed-point distances, falls back to
+                  // BinaryHeap if the weights are too small to quantize
+};
+
+void setQueueBackend(QueueBackend backend);
+QueueBackend getQueueBackend();
+
+// A* search guided by heuristicDistance()
 Path findPathAStar(int startNode, int endNode);
 
-// Utility: Calculate heuristic distance (Euclidean)
+// Utility: Admissible heuristic distance for the current HeuristicMode
 double heuristicDistance(int node1, int node2);
 
 #endif
\ No newline at end of file
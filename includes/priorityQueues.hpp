@@ -0,0 +1,159 @@
+#ifndef PRIORITYQUEUES_HPP
+#define PRIORITYQUEUES_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cmath>
+
+// Alternative Dijkstra queues. All of them take (key, node) through
+// update() and hand back the smallest with pop().
+
+// Indexed d-ary min-heap with decrease-key. Every node is in the heap at
+// most once, so unlike the lazy binary heap no stale entries pile up.
+template <int D = 4>
+class IndexedDaryHeap {
+private:
+    std::vector<std::pair<double, int>> heap;
+    std::vector<int> position;   // Index in heap, -1 when the node is not queued
+
+    void place(int i, const std::pair<double, int>& item) {
+        heap[i] = item;
+        position[item.second] = i;
+    }
+
+    void siftUp(int i) {
+        std::pair<double, int> item = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (heap[parent].first <= item.first) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, item);
+    }
+
+    void siftDown(int i) {
+        std::pair<double, int> item = heap[i];
+        int size = static_cast<int>(heap.size());
+        while (true) {
+            int first = i * D + 1;
+            if (first >= size) break;
+            int last = first + D < size ? first + D : size;
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (heap[c].first < heap[best].first) best = c;
+            }
+            if (heap[best].first >= item.first) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, item);
+    }
+
+public:
+    // Leftovers from an early-terminated search are unlinked, so this is
+    // O(remaining entries), not O(nodeCount)
+    void reset(int nodeCount) {
+        for (const auto& item : heap) {
+            position[item.second] = -1;
+        }
+        heap.clear();
+        if (static_cast<int>(position.size()) < nodeCount) {
+            position.resize(nodeCount, -1);
+        }
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+    // Insert, or lower the key if the node is already queued
+    void update(double key, int v) {
+        int i = position[v];
+        if (i < 0) {
+            heap.emplace_back(key, v);
+            siftUp(static_cast<int>(heap.size()) - 1);
+        } else if (key < heap[i].first) {
+            heap[i].first = key;
+            siftUp(i);
+        }
+    }
+
+    std::pair<double, int> pop() {
+        std::pair<double, int> top = heap.front();
+        position[top.second] = -1;
+        std::pair<double, int> last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+};
+
+// Monotone radix heap on fixed-point keys, floor(key * scale). Bucket i
+// holds keys whose highest bit differing from the last popped key is
+// bit i - 1, so each entry moves down at most 64 times in total.
+//
+// Keys must never drop below the last popped key. For Dijkstra that holds,
+// and the order stays exact, as long as every edge weight is >= 1 / scale
+// (two nodes in the same fixed-point step can't improve each other).
+class RadixHeap {
+private:
+    static const int BUCKETS = 65;
+    std::vector<std::pair<uint64_t, int>> buckets[BUCKETS];
+    uint64_t last = 0;
+    size_t count = 0;
+    double scale = 1.0;
+
+    static int bucketFor(uint64_t key, uint64_t last) {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+public:
+    void reset(double fixedPointScale) {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+        scale = fixedPointScale;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    // Lazy like the binary heap: a better key is just another entry
+    void update(double key, int v) {
+        uint64_t fixed = static_cast<uint64_t>(std::floor(key * scale));
+        if (fixed < last) fixed = last;   // Rounding noise only
+        buckets[bucketFor(fixed, last)].emplace_back(fixed, v);
+        ++count;
+    }
+
+    // Key comes back rounded down to the fixed-point step
+    std::pair<double, int> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+
+            uint64_t smallest = buckets[i][0].first;
+            for (const auto& item : buckets[i]) {
+                if (item.first < smallest) smallest = item.first;
+            }
+            last = smallest;
+            for (const auto& item : buckets[i]) {
+                buckets[bucketFor(item.first, last)].push_back(item);
+            }
+            buckets[i].clear();
+        }
+
+        std::pair<uint64_t, int> item = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return {item.first / scale, item.second};
+    }
+};
+
+#endif
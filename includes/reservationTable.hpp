@@ -0,0 +1,67 @@
+#ifndef RESERVATIONTABLE_HPP
+#define RESERVATIONTABLE_HPP
+
+#include "datatypes.hpp"
+#include <vector>
+#include <limits>
+
+// A robot holding a node (or driving along an edge) during [start, end)
+struct Reservation {
+    double start;
+    double end;
+    int robot;
+};
+
+// Maximal time window [start, end) in which a node has room for one more robot
+struct FreeWindow {
+    double start;
+    double end;
+};
+
+// Space-time reservations per node and per CSR edge.
+// Each list is kept sorted on start time in one contiguous vector, and the
+// longest finite entry per list bounds how far back an overlap can begin,
+// so a lookup is a binary search plus a scan over the actual overlaps.
+// Open-ended entries (a robot parked at its goal) live in a separate small list.
+struct ReservationTable {
+    int nodeCount = 0;
+    int edgeCount = 0;
+    unsigned long builtForVersion = 0;
+
+    std::vector<std::vector<Reservation>> nodeReservations;
+    std::vector<double> nodeMaxDuration;
+    std::vector<std::vector<Reservation>> parked;          // end == infinity
+    std::vector<std::vector<Reservation>> edgeReservations;
+    std::vector<double> edgeMaxDuration;
+
+    // Size for the current CSR graph and drop everything
+    void reset();
+
+    void reserveNode(int node, double start, double end, int robot);
+    void reserveEdge(int edgeId, double start, double end, int robot);
+
+    // Free windows of 'node' (capacity maxRobots) that intersect [from, to].
+    // Reservations by ignoreRobot are skipped. The last window may end after
+    // 'to' (infinity if nothing is booked later).
+    void getFreeWindows(int node, double from, double to, int ignoreRobot,
+                        std::vector<FreeWindow>& out) const;
+
+    // Latest end among other robots' reservations of edgeId overlapping
+    // [start, end), or -infinity if the edge is free
+    double getEdgeBlockedUntil(int edgeId, double start, double end, int ignoreRobot) const;
+
+    // Forget a robot's reservations / everything that ended before 'time'
+    void releaseRobot(int robot);
+    void releaseBefore(double time);
+
+    // Same as releaseRobot but limited to one node / one edge
+    void releaseRobotAtNode(int node, int robot);
+    void releaseRobotOnEdge(int edgeId, int robot);
+
+    // Number of stored entries (for stats)
+    size_t getReservationCount() const;
+};
+
+extern ReservationTable reservationTable;
+
+#endif
@@ -20,6 +20,9 @@ std::map<std::string, double> step_simulation(int robotIdx, int actionType, int
 int findProductOnShelf(int productID, int& outSlotIndex);
 int findBestShelfForProduct(int productID);
 
+// Set positionX/Y from node coordinates (interpolated along the current edge while moving)
+void updateRobotPosition(Robot& robot);
+
 // Robot access functions for Python binding
 namespace RobotAccess {
     int getRobotCount();
@@ -0,0 +1,82 @@
+#ifndef SEARCHWORKSPACE_HPP
+#define SEARCHWORKSPACE_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "priorityQueues.hpp"
+
+// Reusable per-thread scratch space for graph searches.
+// Entries are only valid when their stamp equals the current generation,
+// so reset() is O(1) and the arrays/heap storage are never reallocated
+// once they have grown to the graph size.
+struct SearchWorkspace {
+    std::vector<double> dist;
+    std::vector<int> pred;
+    std::vector<unsigned int> seenStamp;     // dist/pred valid when == generation
+    std::vector<unsigned int> closedStamp;   // node settled when == generation
+    std::vector<std::pair<double, int>> heap;
+    unsigned int generation = 0;
+
+    // Optional queue backends (see QueueBackend in pathfinding.hpp).
+    // Searches that use them reset them themselves.
+    IndexedDaryHeap<4> daryHeap;
+    RadixHeap radixHeap;
+
+    void reset(int nodeCount) {
+        if (static_cast<int>(dist.size()) < nodeCount) {
+            dist.resize(nodeCount);
+            pred.resize(nodeCount);
+            seenStamp.resize(nodeCount, 0);
+            closedStamp.resize(nodeCount, 0);
+        }
+        heap.clear();
+
+        // On wrap-around old stamps could collide with the new generation
+        if (++generation == 0) {
+            std::fill(seenStamp.begin(), seenStamp.end(), 0);
+            std::fill(closedStamp.begin(), closedStamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    // Distance / predecessor access
+    double getDist(int v) const {
+        return seenStamp[v] == generation ? dist[v] : std::numeric_limits<double>::infinity();
+    }
+    int getPred(int v) const { return seenStamp[v] == generation ? pred[v] : -1; }
+    bool isSeen(int v) const { return seenStamp[v] == generation; }
+    void setDist(int v, double d, int p) {
+        dist[v] = d;
+        pred[v] = p;
+        seenStamp[v] = generation;
+    }
+
+    // Settled set
+    bool isClosed(int v) const { return closedStamp[v] == generation; }
+    void close(int v) { closedStamp[v] = generation; }
+
+    // Min-heap of (key, node) with lazy deletion
+    bool heapEmpty() const { return heap.empty(); }
+    void push(double key, int v) {
+        heap.emplace_back(key, v);
+        std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<double, int>>());
+    }
+    std::pair<double, int> top() const { return heap.front(); }
+    std::pair<double, int> pop() {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<double, int>>());
+        std::pair<double, int> item = heap.back();
+        heap.pop_back();
+        return item;
+    }
+};
+
+// Workspace owned by the calling thread
+SearchWorkspace& getSearchWorkspace();
+
+// Second per-thread workspace for the backward half of bidirectional searches
+SearchWorkspace& getReverseSearchWorkspace();
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SPACETIMEPLANNER_HPP
+#define SPACETIMEPLANNER_HPP
+
+#include "datatypes.hpp"
+#include "reservationTable.hpp"
+#include <vector>
+
+// Minimum time a robot holds a node after leaving it, so two robots
+// passing through the same node at the same instant still conflict
+const double NODE_CLEARANCE = 0.5;
+
+// Default planning horizon (seconds after the start time)
+const double DEFAULT_PLAN_HORIZON = 600.0;
+
+// Path with a schedule: the robot reaches path.nodes[i] at arrivalTimes[i]
+// and leaves at departureTimes[i] (later than arrival when it has to wait).
+// The last departure time is infinity - the robot stays parked at the goal.
+struct TimedPath {
+    Path path;
+    std::vector<double> arrivalTimes;
+    std::vector<double> departureTimes;
+
+    // Getters
+    bool isFound() const { return path.found; }
+    double getArrivalTime() const { return arrivalTimes.empty() ? 0.0 : arrivalTimes.back(); }
+};
+
+// Space-time A* (safe-interval search) for one robot against 'table'.
+// Respects Node::maxRobots and forbids swapping places along an edge.
+// Travel time along an edge is distance / speed.
+TimedPath findTimedPath(const ReservationTable& table, int robot, int startNode, int goalNode,
+                        double startTime, double speed, double horizon = DEFAULT_PLAN_HORIZON);
+
+// Book the whole schedule (nodes, edges and the parking spot at the goal)
+void reserveTimedPath(ReservationTable& table, int robot, const TimedPath& timedPath);
+
+// Park every robot at its current node from 'time' on (after reset / init)
+void syncReservationsWithRobots(ReservationTable& table, double time);
+
+// When enabled, startRobotMovement plans through the global reservation table
+void setSpaceTimePlanning(bool enabled);
+bool isSpaceTimePlanningEnabled();
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops (batch queries,
+// graph preprocessing). One loop runs at a time; the calling thread works
+// on it too and parallelFor() returns when every index is done. A nested
+// parallelFor() from inside a job runs inline on the current thread.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    std::mutex jobMutex;                    // Serializes parallelFor() callers
+
+    // Current job
+    const std::function<void(int)>* job = nullptr;
+    int jobCount = 0;
+    int jobChunk = 1;
+    std::atomic<int> nextIndex{0};
+    unsigned long jobGeneration = 0;
+    int activeWorkers = 0;
+    bool stopping = false;
+
+    void workerLoop();
+    void runChunks();
+
+public:
+    // threadCount includes the calling thread. 0 = hardware concurrency
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Run fn(i) for every i in [0, count), handing out 'chunk' indices at a time
+    void parallelFor(int count, const std::function<void(int)>& fn, int chunk = 1);
+
+    // Getters
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()) + 1; }
+};
+
+// Shared pool sized to the machine, created on first use
+ThreadPool& getThreadPool();
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Refers to one pending timer of a TimerWheel. Goes stale once the timer
+// fires or is cancelled (the slot's generation moves on).
+struct TimerHandle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isSet() const { return slot != UINT32_MAX; }
+};
+
+// Hierarchical timing wheel (Varghese & Lauck) for periodic jobs and
+// deadlines. Time is cut into ticks of 'resolution' seconds; level 0 has
+// one bucket per tick for the next 64 ticks, level 1 one bucket per 64
+// ticks, and so on. A timer goes straight into the bucket of its level,
+// and when level 0 wraps the next bucket of level 1 is spread out over
+// level 0 (and likewise further up). Schedule, cancel and expire are O(1);
+// each timer is moved at most once per level on its way down.
+//
+// A timer fires on the first tick at or after its time. Timers that fire
+// on the same tick come out in the order they reached level 0.
+template <typename T>
+class TimerWheel {
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int BITS = 6;
+    static constexpr int SLOTS = 1 << BITS;          // Buckets per level
+    static constexpr int32_t NONE = -1;
+    static constexpr int OVERDUE = LEVELS * SLOTS;   // List for timers already due
+
+    // Timer pool. Buckets are doubly linked lists through prev/next, so a
+    // timer can be unlinked from the middle of one.
+    struct Node {
+        T item;
+        double time = 0.0;
+        long long tick = 0;
+        int32_t prev = NONE;
+        int32_t next = NONE;
+        int list = NONE;              // Bucket index (level * SLOTS + slot) or OVERDUE
+        uint32_t generation = 0;
+    };
+
+    struct List {
+        int32_t head = NONE;
+        int32_t tail = NONE;
+    };
+
+    std::vector<Node> pool;
+    std::vector<int32_t> freeNodes;
+    List lists[LEVELS * SLOTS + 1];
+    size_t levelCount[LEVELS + 1] = {};   // Timers per level (last: overdue)
+    double resolution;
+    long long currentTick = 0;        // Every timer up to this tick has fired
+    size_t count = 0;
+
+    long long tickOf(double time) const {
+        return static_cast<long long>(std::ceil(time / resolution - 1e-9));
+    }
+
+    void append(int list, int32_t index) {
+        Node& node = pool[index];
+        node.list = list;
+        levelCount[list / SLOTS]++;
+        node.prev = lists[list].tail;
+        node.next = NONE;
+        if (lists[list].tail != NONE) {
+            pool[lists[list].tail].next = index;
+        } else {
+            lists[list].head = index;
+        }
+        lists[list].tail = index;
+    }
+
+    void unlink(int32_t index) {
+        Node& node = pool[index];
+        List& list = lists[node.list];
+        if (node.prev != NONE) pool[node.prev].next = node.next; else list.head = node.next;
+        if (node.next != NONE) pool[node.next].prev = node.prev; else list.tail = node.prev;
+        levelCount[node.list / SLOTS]--;
+        node.prev = NONE;
+        node.next = NONE;
+        node.list = NONE;
+    }
+
+    // Bucket for a timer 'tick', seen from currentTick
+    int bucketFor(long long tick) const {
+        long long delta = tick - currentTick;
+        if (delta <= 0) return OVERDUE;
+        for (int level = 0; level < LEVELS; ++level) {
+            if (delta < (1LL << (BITS * (level + 1)))) {
+                return level * SLOTS + static_cast<int>((tick >> (BITS * level)) & (SLOTS - 1));
+            }
+        }
+        // Beyond the top level: park in the farthest bucket, re-sorted when it cascades
+        long long farthest = currentTick + (1LL << (BITS * LEVELS)) - 1;
+        return (LEVELS - 1) * SLOTS + static_cast<int>((farthest >> (BITS * (LEVELS - 1))) & (SLOTS - 1));
+    }
+
+    // Spread one bucket of 'level' over the levels below
+    void cascade(int level) {
+        int list = level * SLOTS + static_cast<int>((currentTick >> (BITS * level)) & (SLOTS - 1));
+        int32_t index = lists[list].head;
+        lists[list].head = NONE;
+        lists[list].tail = NONE;
+        while (index != NONE) {
+            int32_t next = pool[index].next;
+            levelCount[level]--;
+            // Timers due this very tick go to the level 0 bucket about to expire
+            long long tick = pool[index].tick;
+            append(tick <= currentTick ? static_cast<int>(currentTick & (SLOTS - 1)) : bucketFor(tick), index);
+            index = next;
+        }
+    }
+
+    void release(int32_t index) {
+        pool[index].generation++;
+        pool[index].list = NONE;
+        freeNodes.push_back(index);
+        --count;
+    }
+
+    void expireList(int list, std::vector<T>& expired) {
+        int32_t index = lists[list].head;
+        lists[list].head = NONE;
+        lists[list].tail = NONE;
+        while (index != NONE) {
+            int32_t next = pool[index].next;
+            levelCount[list / SLOTS]--;
+            expired.push_back(pool[index].item);
+            release(index);
+            index = next;
+        }
+    }
+
+    // Earliest time in one bucket
+    double earliestIn(int list) const {
+        double earliest = std::numeric_limits<double>::infinity();
+        for (int32_t index = lists[list].head; index != NONE; index = pool[index].next) {
+            if (pool[index].time < earliest) earliest = pool[index].time;
+        }
+        return earliest;
+    }
+
+public:
+    explicit TimerWheel(double resolution = 1.0) : resolution(resolution) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+
+    TimerHandle schedule(double time, const T& item) {
+        int32_t index;
+        if (freeNodes.empty()) {
+            index = static_cast<int32_t>(pool.size());
+            pool.emplace_back();
+        } else {
+            index = freeNodes.back();
+            freeNodes.pop_back();
+        }
+
+        Node& node = pool[index];
+        node.item = item;
+        node.time = time;
+        node.tick = tickOf(time);
+        append(bucketFor(node.tick), index);
+        ++count;
+        return TimerHandle{static_cast<uint32_t>(index), node.generation};
+    }
+
+    // True while the timer has neither fired nor been cancelled
+    bool isPending(TimerHandle handle) const {
+        return handle.slot < pool.size() && pool[handle.slot].list != NONE &&
+               pool[handle.slot].generation == handle.generation;
+    }
+
+    // Returns false for a stale handle
+    bool cancel(TimerHandle handle) {
+        if (!isPending(handle)) return false;
+        unlink(static_cast<int32_t>(handle.slot));
+        release(static_cast<int32_t>(handle.slot));
+        return true;
+    }
+
+    // Move the wheel to 'now' and append every timer due by then to 'expired'
+    void advance(double now, std::vector<T>& expired) {
+        expireList(OVERDUE, expired);
+
+        long long target = static_cast<long long>(std::floor(now / resolution + 1e-9));
+        while (currentTick < target && count > 0) {
+            // Skip over empty lower levels straight to the next tick that cascades
+            int empty = 0;
+            while (empty < LEVELS - 1 && levelCount[empty] == 0) ++empty;
+            if (empty > 0) {
+                long long span = 1LL << (BITS * empty);
+                long long boundary = (currentTick / span + 1) * span;
+                if (boundary > target) {
+                    currentTick = target;
+                    break;
+                }
+                currentTick = boundary - 1;
+            }
+
+            ++currentTick;
+            // Each level whose range just wrapped refills the ones below, top down
+            int top = 0;
+            while (top + 1 < LEVELS && (currentTick & ((1LL << (BITS * (top + 1))) - 1)) == 0) ++top;
+            for (int level = top; level >= 1; --level) cascade(level);
+            expireList(static_cast<int>(currentTick & (SLOTS - 1)), expired);
+        }
+        if (currentTick < target) currentTick = target;   // Nothing pending; just move the clock
+    }
+
+    // Time of the earliest pending timer, or +infinity when there is none
+    double getNextExpiry() const {
+        double earliest = earliestIn(OVERDUE);
+        for (int level = 0; level < LEVELS; ++level) {
+            int current = static_cast<int>((currentTick >> (BITS * level)) & (SLOTS - 1));
+            for (int step = 1; step <= SLOTS; ++step) {
+                int list = level * SLOTS + ((current + step) & (SLOTS - 1));
+                if (lists[list].head != NONE) {
+                    double candidate = earliestIn(list);
+                    if (candidate < earliest) earliest = candidate;
+                    // The top level also holds timers parked beyond its range, so look at all of it
+                    if (level < LEVELS - 1) break;
+                }
+            }
+        }
+        return earliest;
+    }
+
+    // Drop every timer (handles go stale) and restart the clock at 'now'
+    void clear(double now = 0.0) {
+        for (int list = 0; list <= OVERDUE; ++list) {
+            int32_t index = lists[list].head;
+            while (index != NONE) {
+                int32_t next = pool[index].next;
+                release(index);
+                index = next;
+            }
+            levelCount[list / SLOTS] = 0;
+            lists[list].head = NONE;
+            lists[list].tail = NONE;
+        }
+        currentTick = static_cast<long long>(std::floor(now / resolution + 1e-9));
+    }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef WEIGHTEDSAMPLER_HPP
+#define WEIGHTEDSAMPLER_HPP
+
+#include <vector>
+#include <random>
+#include <cstddef>
+
+// Draws index i with probability weight[i] / total. Weights are kept in a
+// Fenwick tree, so changing one weight and drawing are both O(log n) and a
+// draw allocates nothing. Weights are integers, so the running sums stay
+// exact however many updates are applied.
+class WeightedSampler {
+private:
+    std::vector<long long> weights;
+    std::vector<long long> tree;     // 1-based Fenwick tree over weights
+    long long total = 0;
+    size_t highestStep = 0;          // Largest power of two <= size()
+
+public:
+    // Replace all weights (O(n))
+    void build(const std::vector<long long>& newWeights);
+
+    // Set the weight of index i (negative weights count as 0)
+    void update(size_t i, long long weight);
+
+    // Index drawn by weight; -1 when the total weight is 0
+    int sample(std::mt19937& generator) const;
+
+    // Getters
+    size_t size() const { return weights.size(); }
+    long long getWeight(size_t i) const { return weights[i]; }
+    long long getTotal() const { return total; }
+};
+
+// Product demand. Customer orders favour popular products, deliveries the
+// unpopular ones. Both samplers follow the weights of 'products' by index.
+int sampleOrderProductIndex(std::mt19937& generator);
+int sampleDeliveryProductIndex(std::mt19937& generator);
+
+// Refresh one product after its popularity changed
+void updateProductDemand(size_t productIdx);
+
+// Rebuild both samplers from 'products' (also done automatically when the
+// product count changes)
+void rebuildProductDemand();
+
+#endif
@@ -0,0 +1,626 @@
+#include "../includes/cbsPlanner.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/robot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+static const double INF_TIME = std::numeric_limits<double>::infinity();
+
+// Robot id used for constraint entries in the scratch table, so the
+// low-level search never mistakes them for its own bookings
+static const int CONSTRAINT_ROBOT = -2;
+
+static bool multiRobotPlanning = false;
+
+namespace {
+
+// Where and when a robot's plan begins. A robot halfway along an edge
+// plans from the node it is driving towards, from the time it gets there.
+struct Agent {
+    int robot;
+    int start;
+    int goal;
+    double startTime;
+    double speed;
+    bool fixed = false;     // No path: parked at start for good
+};
+
+// Robot 'agent' must not hold node 'from' during [start, end) or, for an
+// edge constraint, must not drive from -> to during [start, end)
+struct Constraint {
+    int agent;
+    bool edge;
+    int from;
+    int to;
+    double start;
+    double end;
+};
+
+struct Conflict {
+    bool found = false;
+    double time = INF_TIME;
+    std::vector<Constraint> branches;   // One child per entry
+};
+
+// Conflict-tree node. Constraints are stored as a chain to the root, paths
+// as indices into a shared pool (only the replanned robot gets a new one).
+struct CTNode {
+    int parent;
+    Constraint constraint;
+    std::vector<int> pathIds;
+    double cost;
+    int conflicts;
+};
+
+// Time a robot spends at path.nodes[i]: [arrival, departure + clearance)
+struct Occupancy {
+    double start;
+    double end;
+    int agent;          // -1 for a robot that is not part of the plan
+    bool branchable;    // False for the start of a plan (it is already there)
+};
+
+double occupancyEnd(const TimedPath& timed, size_t i) {
+    double departure = timed.departureTimes[i];
+    return departure == INF_TIME ? INF_TIME : departure + NODE_CLEARANCE;
+}
+
+double planCost(const Agent& agent, const TimedPath& timed) {
+    return timed.isFound() ? timed.getArrivalTime() - agent.startTime : 0.0;
+}
+
+// Robot positions that are not up for planning, plus agents without a path
+void parkFixedRobots(ReservationTable& table, const std::vector<bool>& planned,
+                     const std::vector<Agent>& agents, double startTime) {
+    for (size_t i = 0; i < robots.size(); ++i) {
+        if (!planned[i]) {
+            table.reserveNode(robots[i].getCurrentNode(), startTime, INF_TIME, static_cast<int>(i));
+        }
+    }
+    for (const Agent& agent : agents) {
+        if (agent.fixed) {
+            table.reserveNode(agent.start, agent.startTime, INF_TIME, agent.robot);
+        }
+    }
+}
+
+Agent makeAgent(int robotIdx, int goal, double startTime) {
+    const Robot& robot = robots[robotIdx];
+    Agent agent{robotIdx, robot.getCurrentNode(), goal, startTime, robot.getSpeed()};
+
+    int next = robot.getTargetNode();
+    if (robot.isMoving() && next >= 0 && next != agent.start && next < static_cast<int>(nodes.size())) {
+        double weight = lightestEdgeWeight(getCSRGraph(), agent.start, next);
+        if (weight != INF_TIME) {
+            double remaining = std::max(0.0, 1.0 - robot.getProgress());
+            agent.start = next;
+            agent.startTime = startTime + remaining * weight / agent.speed;
+        }
+    }
+    return agent;
+}
+
+class ConflictDetector {
+public:
+    // Earliest conflict among the agents' paths (and the parked robots), with
+    // one constraint per robot that could give way. Counts all conflicts.
+    Conflict detect(const std::vector<Agent>& agents, const std::vector<const TimedPath*>& paths,
+                    const std::vector<std::pair<int, double>>& parkedRobots, int& conflictCount) {
+        conflictCount = 0;
+        Conflict first;
+
+        for (int node : touchedNodes) occupancy[node].clear();
+        touchedNodes.clear();
+        traversals.clear();
+
+        auto addOccupancy = [&](int node, const Occupancy& o) {
+            if (occupancy[node].empty()) touchedNodes.push_back(node);
+            occupancy[node].push_back(o);
+        };
+
+        for (const auto& [node, time] : parkedRobots) {
+            addOccupancy(node, {time, INF_TIME, -1, false});
+        }
+        for (size_t a = 0; a < agents.size(); ++a) {
+            const TimedPath* timed = paths[a];
+            if (!timed || !timed->isFound()) continue;
+
+            const std::vector<int>& route = timed->path.nodes;
+            for (size_t i = 0; i < route.size(); ++i) {
+                addOccupancy(route[i], {timed->arrivalTimes[i], occupancyEnd(*timed, i),
+                                        static_cast<int>(a), i > 0});
+                if (i + 1 < route.size()) {
+                    traversals.push_back({route[i], route[i + 1], timed->departureTimes[i],
+                                          timed->arrivalTimes[i + 1], static_cast<int>(a)});
+                }
+            }
+        }
+
+        for (int node : touchedNodes) {
+            detectAtNode(node, conflictCount, first);
+        }
+        detectSwaps(conflictCount, first);
+        return first;
+    }
+
+    void resize(size_t nodeCount) {
+        if (occupancy.size() != nodeCount) {
+            occupancy.assign(nodeCount, {});
+            touchedNodes.clear();
+        }
+    }
+
+private:
+    struct Traversal {
+        int from;
+        int to;
+        double start;
+        double end;
+        int agent;
+    };
+
+    std::vector<std::vector<Occupancy>> occupancy;
+    std::vector<int> touchedNodes;
+    std::vector<Traversal> traversals;
+    std::vector<std::pair<double, int>> events;
+    std::vector<int> active;
+
+    // Sweep the occupancies of one node. Overflow caused only by robots that
+    // start there is not a conflict - the low-level search lets them leave.
+    void detectAtNode(int node, int& conflictCount, Conflict& first) {
+        const std::vector<Occupancy>& list = occupancy[node];
+        int capacity = std::max(1, nodes[node].maxRobots);
+        if (static_cast<int>(list.size()) <= capacity) return;
+
+        events.clear();
+        for (size_t i = 0; i < list.size(); ++i) {
+            events.emplace_back(list[i].start, static_cast<int>(i) + 1);
+            if (list[i].end != INF_TIME) events.emplace_back(list[i].end, -static_cast<int>(i) - 1);
+        }
+        // Releases sort before arrivals at the same instant
+        std::sort(events.begin(), events.end());
+
+        active.clear();
+        bool inConflict = false;
+        for (const auto& [time, signedIndex] : events) {
+            if (signedIndex < 0) {
+                active.erase(std::find(active.begin(), active.end(), -signedIndex - 1));
+                if (static_cast<int>(active.size()) <= capacity) inConflict = false;
+                continue;
+            }
+            active.push_back(signedIndex - 1);
+            if (static_cast<int>(active.size()) <= capacity || inConflict) continue;
+
+            bool branchable = false;
+            for (int i : active) branchable = branchable || list[i].branchable;
+            if (!branchable) continue;
+
+            inConflict = true;
+            ++conflictCount;
+            if (time >= first.time) continue;
+
+            first.found = true;
+            first.time = time;
+            first.branches.clear();
+            for (int i : active) {
+                if (!list[i].branchable) continue;
+
+                // Keep robot i out while all the others are there
+                double start = -INF_TIME;
+                double end = INF_TIME;
+                for (int j : active) {
+                    if (j == i) continue;
+                    start = std::max(start, list[j].start);
+                    end = std::min(end, list[j].end);
+                }
+                first.branches.push_back({list[i].agent, false, node, node, start, end});
+            }
+        }
+    }
+
+    // Two robots driving the same edge in opposite directions at once
+    void detectSwaps(int& conflictCount, Conflict& first) {
+        if (traversals.size() < 2) return;
+
+        std::sort(traversals.begin(), traversals.end(), [](const Traversal& x, const Traversal& y) {
+            int xa = std::min(x.from, x.to), ya = std::min(y.from, y.to);
+            if (xa != ya) return xa < ya;
+            int xb = std::max(x.from, x.to), yb = std::max(y.from, y.to);
+            if (xb != yb) return xb < yb;
+            return x.start < y.start;
+        });
+
+        size_t groupBegin = 0;
+        while (groupBegin < traversals.size()) {
+            const Traversal& head = traversals[groupBegin];
+            int lo = std::min(head.from, head.to), hi = std::max(head.from, head.to);
+            size_t groupEnd = groupBegin + 1;
+            while (groupEnd < traversals.size() && std::min(traversals[groupEnd].from, traversals[groupEnd].to) == lo &&
+                   std::max(traversals[groupEnd].from, traversals[groupEnd].to) == hi) {
+                ++groupEnd;
+            }
+
+            for (size_t i = groupBegin; i < groupEnd; ++i) {
+                const Traversal& x = traversals[i];
+                for (size_t j = i + 1; j < groupEnd && traversals[j].start < x.end; ++j) {
+                    const Traversal& y = traversals[j];
+                    if (y.from != x.to || y.agent == x.agent || y.end <= x.start) continue;
+
+                    ++conflictCount;
+                    double time = std::max(x.start, y.start);
+                    if (time >= first.time) continue;
+
+                    first.found = true;
+                    first.time = time;
+                    first.branches = {{x.agent, true, x.from, x.to, y.start, y.end},
+                                      {y.agent, true, y.from, y.to, x.start, x.end}};
+                }
+            }
+            groupBegin = groupEnd;
+        }
+    }
+};
+
+// Low-level search for one agent under its constraints. The constraints are
+// written into the scratch table for the duration of the call.
+class LowLevelPlanner {
+public:
+    explicit LowLevelPlanner(ReservationTable& table) : table(table) {}
+
+    TimedPath plan(const Agent& agent, const std::vector<Constraint>& constraints, double horizon) {
+        const CSRGraph& graph = getCSRGraph();
+        for (const Constraint& c : constraints) {
+            if (!c.edge) {
+                int capacity = std::max(1, nodes[c.from].maxRobots);
+                for (int k = 0; k < capacity; ++k) {
+                    table.reserveNode(c.from, c.start, c.end, CONSTRAINT_ROBOT);
+                }
+            } else {
+                // The planner refuses to enter an edge against oncoming traffic
+                for (int e = graph.getEdgeBegin(c.to); e < graph.getEdgeEnd(c.to); ++e) {
+                    if (graph.targets[e] == c.from) table.reserveEdge(e, c.start, c.end, CONSTRAINT_ROBOT);
+                }
+            }
+        }
+
+        TimedPath timed = findTimedPath(table, agent.robot, agent.start, agent.goal, agent.startTime,
+                                        agent.speed, horizon + (agent.startTime - horizonStart));
+
+        for (const Constraint& c : constraints) {
+            if (!c.edge) {
+                table.releaseRobotAtNode(c.from, CONSTRAINT_ROBOT);
+            } else {
+                for (int e = graph.getEdgeBegin(c.to); e < graph.getEdgeEnd(c.to); ++e) {
+                    if (graph.targets[e] == c.from) table.releaseRobotOnEdge(e, CONSTRAINT_ROBOT);
+                }
+            }
+        }
+        return timed;
+    }
+
+    double horizonStart = 0.0;
+
+private:
+    ReservationTable& table;
+};
+
+std::vector<Agent> buildAgents(const std::vector<int>& robotIds, const std::vector<int>& goals,
+                               double startTime, std::vector<bool>& planned) {
+    std::vector<Agent> agents;
+    planned.assign(robots.size(), false);
+    int nodeCount = static_cast<int>(nodes.size());
+
+    for (size_t i = 0; i < robotIds.size() && i < goals.size(); ++i) {
+        int robot = robotIds[i];
+        if (robot < 0 || robot >= static_cast<int>(robots.size()) || planned[robot]) continue;
+        if (goals[i] < 0 || goals[i] >= nodeCount) continue;
+
+        planned[robot] = true;
+        agents.push_back(makeAgent(robot, goals[i], startTime));
+    }
+    return agents;
+}
+
+MultiRobotPlan makePlan(const std::vector<Agent>& agents) {
+    MultiRobotPlan plan;
+    for (const Agent& agent : agents) {
+        plan.robotIds.push_back(agent.robot);
+        plan.goals.push_back(agent.goal);
+    }
+    return plan;
+}
+
+void finishPlan(MultiRobotPlan& plan, const std::vector<Agent>& agents, double startTime,
+                std::chrono::steady_clock::time_point began) {
+    std::vector<bool> planned(robots.size(), false);
+    std::vector<std::pair<int, double>> parkedRobots;
+    for (const Agent& agent : agents) planned[agent.robot] = true;
+    for (size_t i = 0; i < robots.size(); ++i) {
+        if (!planned[i]) parkedRobots.emplace_back(robots[i].getCurrentNode(), startTime);
+    }
+
+    std::vector<const TimedPath*> paths;
+    plan.sumOfCosts = 0.0;
+    for (size_t a = 0; a < agents.size(); ++a) {
+        if (plan.paths[a].isFound()) {
+            paths.push_back(&plan.paths[a]);
+            plan.sumOfCosts += planCost(agents[a], plan.paths[a]);
+        } else {
+            paths.push_back(nullptr);
+            parkedRobots.emplace_back(agents[a].start, agents[a].startTime);
+        }
+    }
+
+    ConflictDetector detector;
+    detector.resize(nodes.size());
+    int conflicts = 0;
+    detector.detect(agents, paths, parkedRobots, conflicts);
+    plan.conflictFree = conflicts == 0;
+
+    plan.planningMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - began).count();
+}
+
+MultiRobotPlan runPrioritized(const std::vector<Agent>& agents, const std::vector<bool>& planned,
+                              double startTime, double horizon) {
+    auto began = std::chrono::steady_clock::now();
+    MultiRobotPlan plan = makePlan(agents);
+    plan.usedFallback = true;
+
+    thread_local ReservationTable table;
+    table.reset();
+    parkFixedRobots(table, planned, agents, startTime);
+
+    // Robots not planned yet wait at their start, so earlier ones go around them
+    for (const Agent& agent : agents) {
+        table.reserveNode(agent.start, agent.startTime, INF_TIME, agent.robot);
+    }
+
+    for (const Agent& agent : agents) {
+        table.releaseRobotAtNode(agent.start, agent.robot);
+        TimedPath timed = findTimedPath(table, agent.robot, agent.start, agent.goal, agent.startTime,
+                                        agent.speed, horizon + (agent.startTime - startTime));
+        ++plan.lowLevelSearches;
+        if (timed.isFound()) {
+            reserveTimedPath(table, agent.robot, timed);
+        } else {
+            table.reserveNode(agent.start, agent.startTime, INF_TIME, agent.robot);
+        }
+        plan.paths.push_back(std::move(timed));
+    }
+
+    finishPlan(plan, agents, startTime, began);
+    return plan;
+}
+
+} // namespace
+
+int MultiRobotPlan::getFoundCount() const {
+    int count = 0;
+    for (const TimedPath& timed : paths) {
+        if (timed.isFound()) ++count;
+    }
+    return count;
+}
+
+void setMultiRobotPlanning(bool enabled) {
+    multiRobotPlanning = enabled;
+}
+
+bool isMultiRobotPlanningEnabled() {
+    return multiRobotPlanning;
+}
+
+MultiRobotPlan planPrioritized(const std::vector<int>& robotIds, const std::vector<int>& goals,
+                               double startTime, double horizon) {
+    std::vector<bool> planned;
+    std::vector<Agent> agents = buildAgents(robotIds, goals, startTime, planned);
+    return runPrioritized(agents, planned, startTime, horizon);
+}
+
+// Conflict-based search: every robot plans alone, then the earliest conflict
+// between two plans is resolved by branching - in each child one of the
+// robots involved gets a constraint keeping it out of the others' way and
+// replans. The high level is ECBS-style: among the open nodes within
+// 'suboptimality' of the cheapest, the one with the fewest conflicts is
+// expanded first, which finds a conflict-free plan much sooner on busy floors.
+MultiRobotPlan planMultiRobotPaths(const std::vector<int>& robotIds, const std::vector<int>& goals,
+                                   double startTime, const CBSConfig& config) {
+    auto began = std::chrono::steady_clock::now();
+    auto elapsedMs = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - began).count();
+    };
+
+    std::vector<bool> planned;
+    std::vector<Agent> agents = buildAgents(robotIds, goals, startTime, planned);
+    MultiRobotPlan plan = makePlan(agents);
+    if (agents.empty()) {
+        plan.conflictFree = true;
+        return plan;
+    }
+
+    thread_local ReservationTable table;
+    table.reset();
+    parkFixedRobots(table, planned, agents, startTime);
+    LowLevelPlanner lowLevel(table);
+    lowLevel.horizonStart = startTime;
+    int lowLevelSearches = 0;
+
+    // Root: everyone on their own. Robots that cannot reach their goal even
+    // then stay parked and the others route around them.
+    std::vector<TimedPath> pool;
+    std::vector<int> rootPaths(agents.size(), -1);
+    for (size_t a = 0; a < agents.size(); ++a) {
+        TimedPath timed = lowLevel.plan(agents[a], {}, config.horizon);
+        ++lowLevelSearches;
+        if (timed.isFound()) {
+            rootPaths[a] = static_cast<int>(pool.size());
+            pool.push_back(std::move(timed));
+        } else {
+            agents[a].fixed = true;
+            table.reserveNode(agents[a].start, agents[a].startTime, INF_TIME, agents[a].robot);
+        }
+    }
+
+    std::vector<std::pair<int, double>> parkedRobots;
+    for (size_t i = 0; i < robots.size(); ++i) {
+        if (!planned[i]) parkedRobots.emplace_back(robots[i].getCurrentNode(), startTime);
+    }
+    for (const Agent& agent : agents) {
+        if (agent.fixed) parkedRobots.emplace_back(agent.start, agent.startTime);
+    }
+
+    ConflictDetector detector;
+    detector.resize(nodes.size());
+    std::vector<const TimedPath*> pathView(agents.size());
+    auto viewOf = [&](const std::vector<int>& pathIds) -> const std::vector<const TimedPath*>& {
+        for (size_t a = 0; a < agents.size(); ++a) {
+            pathView[a] = pathIds[a] >= 0 ? &pool[pathIds[a]] : nullptr;
+        }
+        return pathView;
+    };
+
+    std::vector<CTNode> tree;
+    double rootCost = 0.0;
+    for (size_t a = 0; a < agents.size(); ++a) {
+        if (rootPaths[a] >= 0) rootCost += planCost(agents[a], pool[rootPaths[a]]);
+    }
+    int rootConflicts = 0;
+    detector.detect(agents, viewOf(rootPaths), parkedRobots, rootConflicts);
+    tree.push_back({-1, {}, rootPaths, rootCost, rootConflicts});
+
+    // Open list ordered on cost; the focal choice scans its cheap prefix
+    std::set<std::pair<double, int>> open;
+    open.insert({rootCost, 0});
+
+    int solution = -1;
+    int expanded = 0;
+    std::vector<Constraint> constraints;
+    double suboptimality = std::max(1.0, config.suboptimality);
+
+    while (!open.empty()) {
+        if (expanded >= config.maxExpansions || elapsedMs() > config.timeBudgetMs) break;
+
+        double bound = open.begin()->first * suboptimality + 1e-9;
+        auto pick = open.begin();
+        for (auto it = open.begin(); it != open.end() && it->first <= bound; ++it) {
+            if (tree[it->second].conflicts < tree[pick->second].conflicts) pick = it;
+        }
+        int current = pick->second;
+        open.erase(pick);
+
+        int conflictCount = 0;
+        Conflict conflict = detector.detect(agents, viewOf(tree[current].pathIds), parkedRobots, conflictCount);
+        if (!conflict.found) {
+            solution = current;
+            break;
+        }
+        ++expanded;
+
+        for (const Constraint& branch : conflict.branches) {
+            constraints.clear();
+            constraints.push_back(branch);
+            for (int n = current; n > 0; n = tree[n].parent) {
+                if (tree[n].constraint.agent == branch.agent) constraints.push_back(tree[n].constraint);
+            }
+
+            TimedPath timed = lowLevel.plan(agents[branch.agent], constraints, config.horizon);
+            ++lowLevelSearches;
+            if (!timed.isFound()) continue;
+
+            CTNode child{current, branch, tree[current].pathIds, tree[current].cost, 0};
+            int oldPath = child.pathIds[branch.agent];
+            child.cost += planCost(agents[branch.agent], timed) - planCost(agents[branch.agent], pool[oldPath]);
+            child.pathIds[branch.agent] = static_cast<int>(pool.size());
+            pool.push_back(std::move(timed));
+
+            detector.detect(agents, viewOf(child.pathIds), parkedRobots, child.conflicts);
+            int index = static_cast<int>(tree.size());
+            open.insert({child.cost, index});
+            tree.push_back(std::move(child));
+        }
+    }
+
+    if (solution == -1) {
+        std::cerr << "[CBS] No conflict-free plan within budget (" << expanded << " expansions, "
+                  << elapsedMs() << " ms), falling back to prioritized planning\n";
+        MultiRobotPlan fallback = runPrioritized(agents, planned, startTime, config.horizon);
+        fallback.expandedNodes = expanded;
+        fallback.lowLevelSearches += lowLevelSearches;
+        fallback.planningMs = elapsedMs();
+        return fallback;
+    }
+
+    for (size_t a = 0; a < agents.size(); ++a) {
+        int pathId = tree[solution].pathIds[a];
+        plan.paths.push_back(pathId >= 0 ? std::move(pool[pathId]) : TimedPath());
+    }
+    plan.expandedNodes = expanded;
+    plan.lowLevelSearches = lowLevelSearches;
+    finishPlan(plan, agents, startTime, began);
+    return plan;
+}
+
+MultiRobotPlan planPendingRobots(double startTime, const CBSConfig& config) {
+    std::vector<int> robotIds;
+    std::vector<int> goals;
+
+    for (size_t i = 0; i < robots.size(); ++i) {
+        const Robot& robot = robots[i];
+        const Path* path = robot.getCurrentPath();
+        int goal = (robot.isMoving() && path && path->found && !path->nodes.empty())
+            ? path->nodes.back() : robot.getTargetNode();
+
+        if (goal < 0 || goal == robot.getCurrentNode()) continue;
+        if (!robot.isMoving() && !robot.isIdle()) continue;
+
+        robotIds.push_back(static_cast<int>(i));
+        goals.push_back(goal);
+    }
+
+    return planMultiRobotPaths(robotIds, goals, startTime, config);
+}
+
+void applyMultiRobotPlan(const MultiRobotPlan& plan, ReservationTable& table, double startTime) {
+    const CSRGraph& graph = getCSRGraph();
+    std::vector<bool> planned(robots.size(), false);
+
+    table.reset();
+    for (size_t a = 0; a < plan.robotIds.size(); ++a) {
+        int robotIdx = plan.robotIds[a];
+        const TimedPath& timed = plan.paths[a];
+        if (!timed.isFound()) continue;
+
+        planned[robotIdx] = true;
+        reserveTimedPath(table, robotIdx, timed);
+
+        Robot& robot = robots[robotIdx];
+        Path route;
+        route.totalDistance = 0.0;
+        if (robot.getCurrentNode() != timed.path.nodes.front()) {
+            // Still on its way to the first node of the plan
+            route.nodes.push_back(robot.getCurrentNode());
+            route.totalDistance = lightestEdgeWeight(graph, robot.getCurrentNode(), timed.path.nodes.front());
+        }
+        route.nodes.insert(route.nodes.end(), timed.path.nodes.begin(), timed.path.nodes.end());
+        route.totalDistance += timed.path.totalDistance;
+        route.found = true;
+
+        if (robot.isIdle() && route.nodes.size() > 1) {
+            robot.setTargetNode(route.nodes[1]);
+            robot.setStatus(RobotStatus::Moving);
+            robot.setProgress(0.0);
+        }
+        robot.currentPath = std::make_shared<const Path>(std::move(route));
+    }
+
+    for (size_t i = 0; i < robots.size(); ++i) {
+        if (!planned[i]) {
+            table.reserveNode(robots[i].getCurrentNode(), startTime, INF_TIME, static_cast<int>(i));
+        }
+    }
+}
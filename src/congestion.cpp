@@ -0,0 +1,281 @@
+#include "../includes/congestion.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include "../includes/logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+CongestionModel congestionModel;
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+
+static bool congestionAwareRouting = false;
+
+namespace {
+
+struct ChangedEdge {
+    int from;
+    int edge;
+    double oldWeight;
+};
+
+void ensureModel() {
+    const CSRGraph& graph = getCSRGraph();
+    CongestionModel& model = congestionModel;
+    if (model.initialized && model.builtForVersion == graphVersion) return;
+
+    model.nodePenalty.assign(graph.nodeCount, 0.0);
+    model.recentOccupancy.assign(graph.nodeCount, 0.0);
+    model.lastHeatTime.assign(graph.nodeCount, 0.0);
+    model.weights = graph.weights;
+    model.trees.clear();
+    model.builtForVersion = graphVersion;
+    model.initialized = true;
+}
+
+// Pop settled nodes and relax every edge that leads into them
+void propagate(const CSRGraph& graph, CongestionTree& tree, SearchWorkspace& ws, long long& settled) {
+    const std::vector<double>& weights = congestionModel.weights;
+
+    while (!ws.heapEmpty()) {
+        auto [d, x] = ws.pop();
+        if (d > tree.dist[x]) continue;
+        ++settled;
+
+        for (int r = graph.getRevEdgeBegin(x); r < graph.getRevEdgeEnd(x); ++r) {
+            int y = graph.revSources[r];
+            int e = graph.revEdgeIds[r];
+            double candidate = d + weights[e];
+            if (candidate < tree.dist[y]) {
+                tree.dist[y] = candidate;
+                tree.nextEdge[y] = e;
+                ws.push(candidate, y);
+            }
+        }
+    }
+}
+
+void buildTree(const CSRGraph& graph, CongestionTree& tree) {
+    tree.dist.assign(graph.nodeCount, INF_DIST);
+    tree.nextEdge.assign(graph.nodeCount, -1);
+
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+    tree.dist[tree.goal] = 0.0;
+    ws.push(0.0, tree.goal);
+
+    long long settled = 0;
+    propagate(graph, tree, ws, settled);
+    congestionModel.treeBuilds++;
+}
+
+// Dynamic SSSP repair (Ramalingam-Reps style) on a tree towards the goal.
+// Only the subtrees hanging below a more expensive tree edge are reset;
+// cheaper edges just seed the normal Dijkstra relaxation.
+void repairTree(const CSRGraph& graph, CongestionTree& tree, const std::vector<ChangedEdge>& changed) {
+    const std::vector<double>& weights = congestionModel.weights;
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+
+    // 1. Collect nodes whose route used an edge that got more expensive
+    //    (the workspace closed stamp marks them)
+    thread_local std::vector<int> affected;
+    thread_local std::vector<int> stack;
+    affected.clear();
+
+    for (const ChangedEdge& c : changed) {
+        if (weights[c.edge] <= c.oldWeight || tree.nextEdge[c.from] != c.edge || ws.isClosed(c.from)) {
+            continue;
+        }
+        stack.clear();
+        stack.push_back(c.from);
+        while (!stack.empty()) {
+            int y = stack.back();
+            stack.pop_back();
+            if (ws.isClosed(y)) continue;
+            ws.close(y);
+            affected.push_back(y);
+
+            for (int r = graph.getRevEdgeBegin(y); r < graph.getRevEdgeEnd(y); ++r) {
+                int z = graph.revSources[r];
+                if (tree.nextEdge[z] == graph.revEdgeIds[r] && !ws.isClosed(z)) {
+                    stack.push_back(z);
+                }
+            }
+        }
+    }
+
+    for (int y : affected) {
+        tree.dist[y] = INF_DIST;
+        tree.nextEdge[y] = -1;
+    }
+
+    // 2. Reconnect them through their unaffected neighbours
+    for (int y : affected) {
+        for (int e = graph.getEdgeBegin(y); e < graph.getEdgeEnd(y); ++e) {
+            int x = graph.targets[e];
+            if (ws.isClosed(x)) continue;
+            double candidate = weights[e] + tree.dist[x];
+            if (candidate < tree.dist[y]) {
+                tree.dist[y] = candidate;
+                tree.nextEdge[y] = e;
+            }
+        }
+        if (tree.dist[y] != INF_DIST) {
+            ws.push(tree.dist[y], y);
+        }
+    }
+
+    // 3. Edges that got cheaper may offer shortcuts
+    for (const ChangedEdge& c : changed) {
+        if (weights[c.edge] >= c.oldWeight) continue;
+        double candidate = weights[c.edge] + tree.dist[graph.targets[c.edge]];
+        if (candidate < tree.dist[c.from]) {
+            tree.dist[c.from] = candidate;
+            tree.nextEdge[c.from] = c.edge;
+            ws.push(candidate, c.from);
+        }
+    }
+
+    // 4. Ordinary Dijkstra from the seeds
+    propagate(graph, tree, ws, congestionModel.repairSettled);
+    congestionModel.treeRepairs++;
+}
+
+} // namespace
+
+void setCongestionAwareRouting(bool enabled) {
+    congestionAwareRouting = enabled;
+}
+
+bool isCongestionAwareRoutingEnabled() {
+    return congestionAwareRouting;
+}
+
+void updateCongestion(int steps) {
+    ensureModel();
+    const CSRGraph& graph = getCSRGraph();
+    CongestionModel& model = congestionModel;
+
+    const std::vector<HeatmapData>* heatmap = globalLogger ? &globalLogger->getHeatmapData() : nullptr;
+
+    // Closed form of 'steps' single-step decays with an even share of the time added each step
+    steps = std::max(1, steps);
+    double decay = steps == 1 ? CONGESTION_HEAT_DECAY : std::pow(CONGESTION_HEAT_DECAY, steps);
+    double gain = steps == 1 ? 1.0 : (1.0 - decay) / ((1.0 - CONGESTION_HEAT_DECAY) * steps);
+
+    thread_local std::vector<ChangedEdge> changed;
+    changed.clear();
+
+    for (int v = 0; v < graph.nodeCount; ++v) {
+        // Heatmap totals only grow during an episode; a drop means a new episode
+        double spent = 0.0;
+        if (heatmap && v < static_cast<int>(heatmap->size())) {
+            double total = (*heatmap)[v].totalTimeSpent;
+            if (total < model.lastHeatTime[v]) model.lastHeatTime[v] = 0.0;
+            spent = total - model.lastHeatTime[v];
+            model.lastHeatTime[v] = total;
+        }
+        model.recentOccupancy[v] = model.recentOccupancy[v] * decay + spent * gain;
+
+        double capacity = std::max(1, nodes[v].maxRobots);
+        double penalty = CONGESTION_ROBOT_WEIGHT * nodes[v].currentRobots / capacity
+                       + CONGESTION_HEAT_WEIGHT * model.recentOccupancy[v] * (1.0 - CONGESTION_HEAT_DECAY) / capacity;
+        penalty = std::max(0.0, penalty);
+
+        if (std::fabs(penalty - model.nodePenalty[v]) < CONGESTION_MIN_CHANGE) continue;
+        model.nodePenalty[v] = penalty;
+
+        for (int r = graph.getRevEdgeBegin(v); r < graph.getRevEdgeEnd(v); ++r) {
+            int e = graph.revEdgeIds[r];
+            changed.push_back({graph.revSources[r], e, model.weights[e]});
+            model.weights[e] = graph.weights[e] * (1.0 + penalty);
+        }
+    }
+
+    if (changed.empty()) return;
+
+    for (CongestionTree& tree : model.trees) {
+        repairTree(graph, tree, changed);
+    }
+}
+
+void applyEdgeChangesToCongestion(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion) {
+    CongestionModel& model = congestionModel;
+    if (!model.initialized || model.builtForVersion != previousVersion) return;
+
+    const CSRGraph& graph = getCSRGraph();
+    thread_local std::vector<ChangedEdge> changed;
+    changed.clear();
+
+    for (const EdgeWeightChange& c : changes) {
+        int v = graph.targets[c.edge];
+        changed.push_back({c.from, c.edge, model.weights[c.edge]});
+        model.weights[c.edge] = graph.weights[c.edge] * (1.0 + model.nodePenalty[v]);
+    }
+
+    for (CongestionTree& tree : model.trees) {
+        repairTree(graph, tree, changed);
+    }
+    model.builtForVersion = graphVersion;
+}
+
+double getCongestedEdgeWeight(int edgeId) {
+    ensureModel();
+    if (edgeId < 0 || edgeId >= static_cast<int>(congestionModel.weights.size())) {
+        return INF_DIST;
+    }
+    return congestionModel.weights[edgeId];
+}
+
+Path findCongestionAwarePath(int startNode, int goalNode) {
+    Path path;
+    path.found = false;
+    path.totalDistance = INF_DIST;
+
+    if (startNode < 0 || startNode >= static_cast<int>(nodes.size()) ||
+        goalNode < 0 || goalNode >= static_cast<int>(nodes.size())) {
+        return path;
+    }
+
+    ensureModel();
+    const CSRGraph& graph = getCSRGraph();
+    CongestionModel& model = congestionModel;
+
+    // Reuse the goal's tree, or build one in place of the least recently used
+    CongestionTree* tree = nullptr;
+    for (CongestionTree& t : model.trees) {
+        if (t.goal == goalNode) tree = &t;
+    }
+    if (!tree) {
+        if (static_cast<int>(model.trees.size()) < CONGESTION_MAX_TREES) {
+            model.trees.emplace_back();
+            tree = &model.trees.back();
+        } else {
+            tree = &*std::min_element(model.trees.begin(), model.trees.end(),
+                                      [](const CongestionTree& a, const CongestionTree& b) {
+                                          return a.lastUsed < b.lastUsed;
+                                      });
+        }
+        tree->goal = goalNode;
+        buildTree(graph, *tree);
+    }
+    tree->lastUsed = ++model.useCounter;
+
+    if (tree->dist[startNode] == INF_DIST) {
+        return path;
+    }
+
+    path.totalDistance = 0.0;
+    path.nodes.push_back(startNode);
+    for (int current = startNode; current != goalNode; ) {
+        int e = tree->nextEdge[current];
+        path.totalDistance += graph.weights[e];
+        current = graph.targets[e];
+        path.nodes.push_back(current);
+    }
+    path.found = true;
+    return path;
+}
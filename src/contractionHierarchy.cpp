@@ -0,0 +1,482 @@
+#include "../includes/contractionHierarchy.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/threadPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <memory>
+
+ContractionHierarchy contractionHierarchy;
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+static const char CH_FILE_MAGIC[4] = {'C', 'H', '0', '1'};
+
+// Witness searches give up after this many settled nodes and keep the shortcut
+// (an unnecessary shortcut only costs memory, never correctness). Priority
+// estimates use a cheaper search than the real contraction.
+static const int WITNESS_SETTLE_LIMIT = 500;
+static const int PRIORITY_SETTLE_LIMIT = 50;
+
+namespace {
+
+struct WorkEdge {
+    int node;
+    double weight;
+    int edgeId;
+};
+
+struct Shortcut {
+    int from;
+    int to;
+    double weight;
+    int firstEdge;
+    int secondEdge;
+};
+
+// Remaining (uncontracted) graph during preprocessing
+struct WorkGraph {
+    std::vector<std::vector<WorkEdge>> out;
+    std::vector<std::vector<WorkEdge>> in;
+    std::vector<char> contracted;
+    std::vector<int> deletedNeighbours;
+};
+
+// Shortcuts needed if v were contracted now. Only reads the work graph,
+// so it can run for many nodes at once (each thread has its own workspace).
+void findShortcuts(const WorkGraph& g, int v, int settleLimit, std::vector<Shortcut>& result) {
+    result.clear();
+    const std::vector<WorkEdge>& outs = g.out[v];
+    if (outs.empty() || g.in[v].empty()) return;
+
+    double maxOut = 0.0;
+    for (const WorkEdge& e : outs) maxOut = std::max(maxOut, e.weight);
+
+    SearchWorkspace& ws = getSearchWorkspace();
+    for (const WorkEdge& inEdge : g.in[v]) {
+        int u = inEdge.node;
+        double maxDist = inEdge.weight + maxOut;
+
+        // Local Dijkstra from u that never passes through v
+        ws.reset(static_cast<int>(g.out.size()));
+        ws.setDist(u, 0.0, -1);
+        ws.push(0.0, u);
+        int settled = 0;
+
+        while (!ws.heapEmpty()) {
+            auto [d, x] = ws.pop();
+            if (ws.isClosed(x)) continue;
+            if (d > maxDist || ++settled > settleLimit) break;
+            ws.close(x);
+
+            for (const WorkEdge& e : g.out[x]) {
+                if (e.node == v || g.contracted[e.node]) continue;
+                double candidate = d + e.weight;
+                if (candidate < ws.getDist(e.node)) {
+                    ws.setDist(e.node, candidate, x);
+                    ws.push(candidate, e.node);
+                }
+            }
+        }
+
+        for (const WorkEdge& outEdge : outs) {
+            int w = outEdge.node;
+            if (w == u) continue;
+            double via = inEdge.weight + outEdge.weight;
+            if (ws.getDist(w) > via) {
+                result.push_back({u, w, via, inEdge.edgeId, outEdge.edgeId});
+            }
+        }
+    }
+}
+
+// Edge difference plus already contracted neighbours (spreads contraction evenly)
+int computePriority(const WorkGraph& g, int v) {
+    thread_local std::vector<Shortcut> scratch;
+    findShortcuts(g, v, PRIORITY_SETTLE_LIMIT, scratch);
+    return static_cast<int>(scratch.size()) - static_cast<int>(g.in[v].size() + g.out[v].size())
+           + g.deletedNeighbours[v];
+}
+
+bool isLocalMinimum(const WorkGraph& g, const std::vector<int>& priority, int v) {
+    for (const std::vector<WorkEdge>* list : {&g.out[v], &g.in[v]}) {
+        for (const WorkEdge& e : *list) {
+            int x = e.node;
+            if (priority[x] < priority[v] || (priority[x] == priority[v] && x < v)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void removeEntry(std::vector<WorkEdge>& list, int node) {
+    list.erase(std::remove_if(list.begin(), list.end(),
+                              [node](const WorkEdge& e) { return e.node == node; }),
+               list.end());
+}
+
+// Insert from -> to, or lower the weight of the existing edge
+void addOrImproveEdge(WorkGraph& g, std::vector<CHEdge>& edges, const Shortcut& s) {
+    for (WorkEdge& e : g.out[s.from]) {
+        if (e.node != s.to) continue;
+        if (e.weight <= s.weight) return;
+
+        int id = static_cast<int>(edges.size());
+        edges.push_back({s.from, s.to, s.weight, s.firstEdge, s.secondEdge});
+        e.weight = s.weight;
+        e.edgeId = id;
+        for (WorkEdge& r : g.in[s.to]) {
+            if (r.node == s.from) {
+                r.weight = s.weight;
+                r.edgeId = id;
+            }
+        }
+        return;
+    }
+
+    int id = static_cast<int>(edges.size());
+    edges.push_back({s.from, s.to, s.weight, s.firstEdge, s.secondEdge});
+    g.out[s.from].push_back({s.to, s.weight, id});
+    g.in[s.to].push_back({s.from, s.weight, id});
+}
+
+void flatten(const std::vector<std::vector<int>>& lists, std::vector<int>& offsets, std::vector<int>& flat) {
+    offsets.assign(lists.size() + 1, 0);
+    for (size_t v = 0; v < lists.size(); ++v) {
+        offsets[v + 1] = offsets[v] + static_cast<int>(lists[v].size());
+    }
+    flat.clear();
+    flat.reserve(offsets.back());
+    for (const std::vector<int>& list : lists) {
+        flat.insert(flat.end(), list.begin(), list.end());
+    }
+}
+
+// Append the original nodes of an edge (excluding its start node)
+void unpackEdge(const ContractionHierarchy& ch, int edgeId, std::vector<int>& outNodes) {
+    thread_local std::vector<int> stack;
+    stack.clear();
+    stack.push_back(edgeId);
+
+    while (!stack.empty()) {
+        const CHEdge& edge = ch.edges[stack.back()];
+        stack.pop_back();
+        if (edge.firstChild < 0) {
+            outNodes.push_back(edge.to);
+        } else {
+            stack.push_back(edge.secondChild);
+            stack.push_back(edge.firstChild);
+        }
+    }
+}
+
+template <typename T>
+void writeVector(std::ofstream& file, const std::vector<T>& data) {
+    long long size = static_cast<long long>(data.size());
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+}
+
+template <typename T>
+bool readVector(std::ifstream& file, std::vector<T>& data) {
+    long long size = 0;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file || size < 0) return false;
+    data.resize(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+void buildContractionHierarchy(unsigned int threadCount) {
+    const CSRGraph& graph = getCSRGraph();
+    int n = graph.nodeCount;
+
+    // Shared pool unless the caller asked for a specific thread count
+    std::unique_ptr<ThreadPool> ownPool;
+    if (threadCount != 0 && threadCount != getThreadPool().getThreadCount()) {
+        ownPool = std::make_unique<ThreadPool>(threadCount);
+    }
+    ThreadPool& pool = ownPool ? *ownPool : getThreadPool();
+    const int chunk = 64;
+
+    ContractionHierarchy ch;
+    ch.nodeCount = n;
+    ch.rank.assign(n, -1);
+
+    WorkGraph g;
+    g.out.resize(n);
+    g.in.resize(n);
+    g.contracted.assign(n, 0);
+    g.deletedNeighbours.assign(n, 0);
+
+    // Original edges (lightest of any parallel edges, no self loops)
+    for (int u = 0; u < n; ++u) {
+        for (int e = graph.getEdgeBegin(u); e < graph.getEdgeEnd(u); ++e) {
+            if (graph.targets[e] != u) {
+                addOrImproveEdge(g, ch.edges, {u, graph.targets[e], graph.weights[e], -1, -1});
+            }
+        }
+    }
+    ch.originalEdgeCount = static_cast<int>(ch.edges.size());
+
+    std::vector<int> priority(n);
+    pool.parallelFor(n, [&](int v) { priority[v] = computePriority(g, v); }, chunk);
+
+    std::vector<std::vector<int>> up(n);
+    std::vector<std::vector<int>> down(n);
+    std::vector<int> remaining(n);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    std::vector<int> selected;
+    std::vector<int> touched;
+    std::vector<std::vector<Shortcut>> pending;
+    int nextRank = 0;
+    int rounds = 0;
+
+    while (!remaining.empty()) {
+        // Nodes that beat all their neighbours form an independent set, so their
+        // shortcuts can be computed in parallel against the same graph
+        selected.clear();
+        for (int v : remaining) {
+            if (isLocalMinimum(g, priority, v)) selected.push_back(v);
+        }
+
+        // Mark the whole set first: witness paths must not lean on a node that
+        // disappears in the same round (missing witnesses only add shortcuts)
+        for (int v : selected) {
+            g.contracted[v] = 1;
+        }
+
+        pending.resize(selected.size());
+        pool.parallelFor(static_cast<int>(selected.size()),
+                         [&](int i) { findShortcuts(g, selected[i], WITNESS_SETTLE_LIMIT, pending[i]); }, chunk);
+
+        touched.clear();
+        for (size_t i = 0; i < selected.size(); ++i) {
+            int v = selected[i];
+            ch.rank[v] = nextRank++;
+
+            for (const WorkEdge& e : g.out[v]) {
+                up[v].push_back(e.edgeId);
+                removeEntry(g.in[e.node], v);
+                g.deletedNeighbours[e.node]++;
+                touched.push_back(e.node);
+            }
+            for (const WorkEdge& e : g.in[v]) {
+                down[v].push_back(e.edgeId);
+                removeEntry(g.out[e.node], v);
+                g.deletedNeighbours[e.node]++;
+                touched.push_back(e.node);
+            }
+            for (const Shortcut& s : pending[i]) {
+                addOrImproveEdge(g, ch.edges, s);
+            }
+
+            std::vector<WorkEdge>().swap(g.out[v]);
+            std::vector<WorkEdge>().swap(g.in[v]);
+        }
+
+        // Only the neighbourhood of contracted nodes changed
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        touched.erase(std::remove_if(touched.begin(), touched.end(),
+                                     [&](int v) { return g.contracted[v] != 0; }),
+                      touched.end());
+        pool.parallelFor(static_cast<int>(touched.size()),
+                         [&](int i) { priority[touched[i]] = computePriority(g, touched[i]); }, chunk);
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&](int v) { return g.contracted[v] != 0; }),
+                        remaining.end());
+        ++rounds;
+    }
+
+    flatten(up, ch.upOffsets, ch.upEdges);
+    flatten(down, ch.downOffsets, ch.downEdges);
+    ch.builtForVersion = graphVersion;
+    ch.graphFingerprint = computeGraphFingerprint(graph);
+    ch.valid = true;
+    contractionHierarchy = std::move(ch);
+
+    std::cerr << "[CH] Contracted " << n << " nodes in " << rounds << " rounds on "
+              << pool.getThreadCount() << " threads, " << contractionHierarchy.getShortcutCount()
+              << " shortcuts\n";
+}
+
+bool isContractionHierarchyValid() {
+    return contractionHierarchy.valid && contractionHierarchy.builtForVersion == graphVersion;
+}
+
+Path findShortestPathCH(int startNode, int endNode) {
+    if (!isContractionHierarchyValid()) {
+        return findShortestPath(startNode, endNode);
+    }
+
+    const ContractionHierarchy& ch = contractionHierarchy;
+    int n = ch.nodeCount;
+
+    Path path;
+    path.totalDistance = INF_DIST;
+    path.found = false;
+
+    if (startNode < 0 || startNode >= n || endNode < 0 || endNode >= n) {
+        return path;
+    }
+    if (startNode == endNode) {
+        path.nodes.push_back(startNode);
+        path.totalDistance = 0.0;
+        path.found = true;
+        return path;
+    }
+
+    // Forward search climbs upward edges from start, backward search climbs
+    // downward edges (reversed) from end. pred holds the CH edge id, not a node.
+    SearchWorkspace& fwd = getSearchWorkspace();
+    SearchWorkspace& bwd = getReverseSearchWorkspace();
+    fwd.reset(n);
+    bwd.reset(n);
+    fwd.setDist(startNode, 0.0, -1);
+    fwd.push(0.0, startNode);
+    bwd.setDist(endNode, 0.0, -1);
+    bwd.push(0.0, endNode);
+
+    double best = INF_DIST;
+    int meeting = -1;
+
+    while (true) {
+        bool fwdActive = !fwd.heapEmpty() && fwd.top().first < best;
+        bool bwdActive = !bwd.heapEmpty() && bwd.top().first < best;
+        if (!fwdActive && !bwdActive) break;
+
+        bool forward = fwdActive && (!bwdActive || fwd.top().first <= bwd.top().first);
+        SearchWorkspace& ws = forward ? fwd : bwd;
+        const SearchWorkspace& other = forward ? bwd : fwd;
+
+        auto [d, u] = ws.pop();
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        double total = d + other.getDist(u);
+        if (total < best) {
+            best = total;
+            meeting = u;
+        }
+
+        if (forward) {
+            for (int k = ch.upOffsets[u]; k < ch.upOffsets[u + 1]; ++k) {
+                int e = ch.upEdges[k];
+                int v = ch.edges[e].to;
+                double candidate = d + ch.edges[e].weight;
+                if (candidate < ws.getDist(v)) {
+                    ws.setDist(v, candidate, e);
+                    ws.push(candidate, v);
+                }
+            }
+        } else {
+            for (int k = ch.downOffsets[u]; k < ch.downOffsets[u + 1]; ++k) {
+                int e = ch.downEdges[k];
+                int v = ch.edges[e].from;
+                double candidate = d + ch.edges[e].weight;
+                if (candidate < ws.getDist(v)) {
+                    ws.setDist(v, candidate, e);
+                    ws.push(candidate, v);
+                }
+            }
+        }
+    }
+
+    if (meeting == -1) {
+        return path;
+    }
+
+    // CH edges start -> meeting, then meeting -> end
+    thread_local std::vector<int> edgePath;
+    edgePath.clear();
+    for (int x = meeting; fwd.getPred(x) != -1; x = ch.edges[fwd.getPred(x)].from) {
+        edgePath.push_back(fwd.getPred(x));
+    }
+    std::reverse(edgePath.begin(), edgePath.end());
+    for (int x = meeting; bwd.getPred(x) != -1; x = ch.edges[bwd.getPred(x)].to) {
+        edgePath.push_back(bwd.getPred(x));
+    }
+
+    path.nodes.push_back(startNode);
+    for (int e : edgePath) {
+        unpackEdge(ch, e, path.nodes);
+    }
+    path.totalDistance = best;
+    path.found = true;
+    return path;
+}
+
+bool saveContractionHierarchy(const std::string& filename) {
+    if (!isContractionHierarchyValid()) {
+        std::cerr << "[CH] No valid index to save\n";
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "[CH] Could not open " << filename << " for writing\n";
+        return false;
+    }
+
+    const ContractionHierarchy& ch = contractionHierarchy;
+    file.write(CH_FILE_MAGIC, sizeof(CH_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&ch.graphFingerprint), sizeof(ch.graphFingerprint));
+    file.write(reinterpret_cast<const char*>(&ch.nodeCount), sizeof(int));
+    file.write(reinterpret_cast<const char*>(&ch.originalEdgeCount), sizeof(int));
+    writeVector(file, ch.rank);
+    writeVector(file, ch.edges);
+    writeVector(file, ch.upOffsets);
+    writeVector(file, ch.upEdges);
+    writeVector(file, ch.downOffsets);
+    writeVector(file, ch.downEdges);
+
+    std::cerr << "[CH] Saved index (" << ch.edges.size() << " edges) to " << filename << "\n";
+    return static_cast<bool>(file);
+}
+
+bool loadContractionHierarchy(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    ContractionHierarchy loaded;
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&loaded.graphFingerprint), sizeof(loaded.graphFingerprint));
+    file.read(reinterpret_cast<char*>(&loaded.nodeCount), sizeof(int));
+    file.read(reinterpret_cast<char*>(&loaded.originalEdgeCount), sizeof(int));
+
+    const CSRGraph& graph = getCSRGraph();
+    if (!file || !std::equal(magic, magic + 4, CH_FILE_MAGIC) ||
+        loaded.graphFingerprint != computeGraphFingerprint(graph) ||
+        loaded.nodeCount != graph.nodeCount) {
+        std::cerr << "[CH] " << filename << " does not match the current graph - ignoring\n";
+        return false;
+    }
+
+    if (!readVector(file, loaded.rank) || !readVector(file, loaded.edges) ||
+        !readVector(file, loaded.upOffsets) || !readVector(file, loaded.upEdges) ||
+        !readVector(file, loaded.downOffsets) || !readVector(file, loaded.downEdges) ||
+        static_cast<int>(loaded.upOffsets.size()) != loaded.nodeCount + 1 ||
+        static_cast<int>(loaded.downOffsets.size()) != loaded.nodeCount + 1) {
+        std::cerr << "[CH] " << filename << " is truncated - ignoring\n";
+        return false;
+    }
+
+    loaded.builtForVersion = graphVersion;
+    loaded.valid = true;
+    contractionHierarchy = std::move(loaded);
+
+    std::cerr << "[CH] Loaded index (" << contractionHierarchy.edges.size() << " edges) from "
+              << filename << "\n";
+    return true;
+}
@@ -0,0 +1,122 @@
+#include "../includes/csrGraph.hpp"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+CSRGraph csrGraph;
+
+double getEffectiveWeight(int fromNode, const Edge& edge) {
+    if (edge.blocked || nodes[fromNode].disabled || nodes[edge.to].disabled) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return edge.distance;
+}
+
+int lightestEdge(const CSRGraph& graph, int from, int to) {
+    if (from < 0 || from >= graph.nodeCount) return -1;
+
+    int best = -1;
+    for (int e = graph.getEdgeBegin(from); e < graph.getEdgeEnd(from); ++e) {
+        if (graph.targets[e] == to && (best == -1 || graph.weights[e] < graph.weights[best])) {
+            best = e;
+        }
+    }
+    return best;
+}
+
+double lightestEdgeWeight(const CSRGraph& graph, int from, int to) {
+    int edge = lightestEdge(graph, from, to);
+    return edge == -1 ? std::numeric_limits<double>::infinity() : graph.weights[edge];
+}
+
+void buildCSRGraph() {
+    int n = static_cast<int>(adj.size());
+
+    csrGraph.nodeCount = n;
+    csrGraph.offsets.assign(n + 1, 0);
+
+    for (int u = 0; u < n; ++u) {
+        csrGraph.offsets[u + 1] = csrGraph.offsets[u] + static_cast<int>(adj[u].size());
+    }
+
+    int m = csrGraph.offsets[n];
+    csrGraph.targets.resize(m);
+    csrGraph.weights.resize(m);
+
+    for (int u = 0; u < n; ++u) {
+        int e = csrGraph.offsets[u];
+        for (const Edge& edge : adj[u]) {
+            csrGraph.targets[e] = edge.to;
+            csrGraph.weights[e] = getEffectiveWeight(u, edge);
+            ++e;
+        }
+    }
+
+    // Reverse graph: counting sort of the forward edges by target
+    csrGraph.revOffsets.assign(n + 1, 0);
+    for (int e = 0; e < m; ++e) {
+        csrGraph.revOffsets[csrGraph.targets[e] + 1]++;
+    }
+    for (int v = 0; v < n; ++v) {
+        csrGraph.revOffsets[v + 1] += csrGraph.revOffsets[v];
+    }
+
+    csrGraph.revSources.resize(m);
+    csrGraph.revWeights.resize(m);
+    csrGraph.revEdgeIds.resize(m);
+    std::vector<int> fill(csrGraph.revOffsets.begin(), csrGraph.revOffsets.end() - 1);
+    for (int u = 0; u < n; ++u) {
+        for (int e = csrGraph.offsets[u]; e < csrGraph.offsets[u + 1]; ++e) {
+            int r = fill[csrGraph.targets[e]]++;
+            csrGraph.revSources[r] = u;
+            csrGraph.revWeights[r] = csrGraph.weights[e];
+            csrGraph.revEdgeIds[r] = e;
+        }
+    }
+
+    // Scale coordinates down wherever an edge is shorter than the straight line
+    csrGraph.coordinateScale = 1.0;
+    for (int u = 0; u < n; ++u) {
+        for (int e = csrGraph.offsets[u]; e < csrGraph.offsets[u + 1]; ++e) {
+            int v = csrGraph.targets[e];
+            double straight = std::hypot(nodes[v].getX() - nodes[u].getX(),
+                                         nodes[v].getY() - nodes[u].getY());
+            if (straight > 0.0 && csrGraph.weights[e] < csrGraph.coordinateScale * straight) {
+                csrGraph.coordinateScale = csrGraph.weights[e] / straight;
+            }
+        }
+    }
+
+    csrGraph.minWeight = m > 0 ? *std::min_element(csrGraph.weights.begin(), csrGraph.weights.end()) : 0.0;
+
+    csrGraph.built = true;
+    csrGraph.builtForVersion = graphVersion;
+
+    std::cerr << "[CSR] Frozen graph: " << n << " nodes, " << m << " edges\n";
+}
+
+const CSRGraph& getCSRGraph() {
+    if (!csrGraph.built || csrGraph.builtForVersion != graphVersion) {
+        buildCSRGraph();
+    }
+    return csrGraph;
+}
+
+unsigned long long computeGraphFingerprint(const CSRGraph& graph) {
+    // FNV-1a over node count, offsets, targets and weights
+    unsigned long long hash = 1469598103934665603ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    mix(&graph.nodeCount, sizeof(graph.nodeCount));
+    mix(graph.offsets.data(), graph.offsets.size() * sizeof(int));
+    mix(graph.targets.data(), graph.targets.size() * sizeof(int));
+    mix(graph.weights.data(), graph.weights.size() * sizeof(double));
+    return hash;
+}
@@ -3,6 +3,8 @@
 std::vector<Node> nodes;
 std::vector<std::vector<Edge>> adj;
 std::vector<Product> products;
+unsigned long graphVersion = 0;
+unsigned long slotLayoutVersion = 0;
 
 int loadingDockNode = -1;
 int shelfANode = -1;
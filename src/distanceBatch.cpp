@@ -0,0 +1,153 @@
+#include "../includes/distanceBatch.hpp"
+#include "../includes/distanceMatrix.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include "../includes/threadPool.hpp"
+#include <algorithm>
+#include <limits>
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+
+static bool validNode(int node) {
+    return node >= 0 && node < static_cast<int>(nodes.size());
+}
+
+// Dijkstra from 'origin' that stops as soon as every goal is settled.
+// With reverse = true it walks incoming edges, so dist is d(v, origin)
+// and pred points one step closer to origin.
+static void searchToGoals(const CSRGraph& graph, int origin, bool reverse,
+                          const std::vector<int>& sortedGoals, SearchWorkspace& ws) {
+    const std::vector<int>& offsets = reverse ? graph.revOffsets : graph.offsets;
+    const std::vector<int>& heads = reverse ? graph.revSources : graph.targets;
+    const std::vector<double>& weights = reverse ? graph.revWeights : graph.weights;
+
+    ws.reset(graph.nodeCount);
+    ws.setDist(origin, 0.0, -1);
+    ws.push(0.0, origin);
+    int remaining = static_cast<int>(sortedGoals.size());
+
+    while (!ws.heapEmpty()) {
+        auto [currentDist, u] = ws.pop();
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        if (std::binary_search(sortedGoals.begin(), sortedGoals.end(), u) && --remaining == 0) {
+            break;
+        }
+
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = heads[e];
+            double candidate = currentDist + weights[e];
+            if (candidate < ws.getDist(v)) {
+                ws.setDist(v, candidate, u);
+                ws.push(candidate, v);
+            }
+        }
+    }
+}
+
+// Path between origin and node in the search tree, always in travel order
+static Path pathFromTree(const SearchWorkspace& ws, int origin, int node, bool reverse) {
+    Path path;
+    path.found = false;
+    path.totalDistance = INF_DIST;
+
+    if (!ws.isSeen(node)) {
+        return path;
+    }
+
+    int hops = 1;
+    for (int current = node; current != origin; current = ws.getPred(current)) {
+        ++hops;
+    }
+
+    path.nodes.resize(hops);
+    int current = node;
+    for (int i = 0; i < hops; ++i) {
+        path.nodes[reverse ? i : hops - 1 - i] = current;
+        current = ws.getPred(current);
+    }
+    path.totalDistance = ws.getDist(node);
+    path.found = true;
+    return path;
+}
+
+DistanceBatch computeDistanceBatch(const std::vector<int>& sources, const std::vector<int>& targets,
+                                   bool withPaths) {
+    DistanceBatch batch;
+    batch.sources = sources;
+    batch.targets = targets;
+
+    size_t sourceCount = sources.size();
+    size_t targetCount = targets.size();
+    batch.dist.assign(sourceCount * targetCount, INF_DIST);
+    if (withPaths) {
+        Path notFound;
+        notFound.found = false;
+        notFound.totalDistance = INF_DIST;
+        batch.paths.assign(sourceCount * targetCount, notFound);
+    }
+    if (sourceCount == 0 || targetCount == 0) {
+        return batch;
+    }
+
+    // Small layouts: everything is already in the all-pairs table
+    if (isDistanceMatrixCurrent()) {
+        for (size_t i = 0; i < sourceCount; ++i) {
+            for (size_t j = 0; j < targetCount; ++j) {
+                if (!validNode(sources[i]) || !validNode(targets[j])) continue;
+                size_t idx = i * targetCount + j;
+                batch.dist[idx] = distanceMatrix.getDistance(sources[i], targets[j]);
+                if (withPaths) {
+                    batch.paths[idx] = getCachedPath(sources[i], targets[j]);
+                }
+            }
+        }
+        return batch;
+    }
+
+    // Search from whichever side is smaller; the other side is the goal set
+    bool perSource = sourceCount <= targetCount;
+    const std::vector<int>& origins = perSource ? sources : targets;
+    const std::vector<int>& others = perSource ? targets : sources;
+
+    std::vector<int> goals;
+    goals.reserve(others.size());
+    for (int node : others) {
+        if (validNode(node)) goals.push_back(node);
+    }
+    std::sort(goals.begin(), goals.end());
+    goals.erase(std::unique(goals.begin(), goals.end()), goals.end());
+
+    // Freeze the graph before fanning out (a lazy rebuild is not thread safe)
+    const CSRGraph& graph = getCSRGraph();
+
+    getThreadPool().parallelFor(static_cast<int>(origins.size()), [&](int r) {
+        int origin = origins[r];
+        if (!validNode(origin)) return;
+
+        SearchWorkspace& ws = getSearchWorkspace();
+        searchToGoals(graph, origin, !perSource, goals, ws);
+
+        for (size_t k = 0; k < others.size(); ++k) {
+            int node = others[k];
+            if (!validNode(node)) continue;
+
+            size_t idx = perSource ? r * targetCount + k : k * targetCount + r;
+            batch.dist[idx] = ws.getDist(node);
+            if (withPaths) {
+                batch.paths[idx] = pathFromTree(ws, origin, node, !perSource);
+            }
+        }
+    });
+
+    return batch;
+}
+
+std::vector<double> oneToManyDistances(int source, const std::vector<int>& targets) {
+    return computeDistanceBatch({source}, targets).dist;
+}
+
+std::vector<double> manyToOneDistances(const std::vector<int>& sources, int target) {
+    return computeDistanceBatch(sources, {target}).dist;
+}
@@ -0,0 +1,205 @@
+#include "../includes/distanceMatrix.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+
+DistanceMatrix distanceMatrix;
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+
+// Dijkstra from one source, filling one row of the table.
+// The first hop is inherited along the relaxed edge, so no extra pass is needed.
+static void computeRow(const CSRGraph& graph, int source, double* distRow, int* hopRow) {
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+
+    distRow[source] = 0.0;
+    hopRow[source] = source;
+    ws.push(0.0, source);
+
+    while (!ws.heapEmpty()) {
+        auto [currentDist, u] = ws.pop();
+
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        for (int e = graph.getEdgeBegin(u); e < graph.getEdgeEnd(u); ++e) {
+            int v = graph.targets[e];
+            double candidate = currentDist + graph.weights[e];
+
+            if (candidate < distRow[v]) {
+                distRow[v] = candidate;
+                hopRow[v] = (u == source) ? v : hopRow[u];
+                ws.push(candidate, v);
+            }
+        }
+    }
+}
+
+void buildDistanceMatrix() {
+    int n = static_cast<int>(nodes.size());
+
+    if (n > ALL_PAIRS_MAX_NODES) {
+        std::cerr << "[DISTANCE] Graph has " << n << " nodes (limit " << ALL_PAIRS_MAX_NODES
+                  << ") - skipping all-pairs table\n";
+        distanceMatrix.valid = false;
+        distanceMatrix.builtForVersion = graphVersion;
+        distanceMatrix.dist.clear();
+        distanceMatrix.nextHop.clear();
+        return;
+    }
+
+    distanceMatrix.nodeCount = n;
+    distanceMatrix.dist.assign(static_cast<size_t>(n) * n, INF_DIST);
+    distanceMatrix.nextHop.assign(static_cast<size_t>(n) * n, -1);
+
+    const CSRGraph& graph = getCSRGraph();
+    for (int s = 0; s < n; ++s) {
+        computeRow(graph, s,
+                   &distanceMatrix.dist[static_cast<size_t>(s) * n],
+                   &distanceMatrix.nextHop[static_cast<size_t>(s) * n]);
+    }
+
+    distanceMatrix.valid = true;
+    distanceMatrix.builtForVersion = graphVersion;
+
+    std::cerr << "[DISTANCE] Built all-pairs table for " << n << " nodes\n";
+}
+
+bool ensureDistanceMatrix() {
+    if (distanceMatrix.builtForVersion != graphVersion ||
+        (distanceMatrix.valid && distanceMatrix.nodeCount != static_cast<int>(nodes.size()))) {
+        buildDistanceMatrix();
+    }
+    return distanceMatrix.valid;
+}
+
+bool isDistanceMatrixCurrent() {
+    return distanceMatrix.valid && distanceMatrix.builtForVersion == graphVersion &&
+           distanceMatrix.nodeCount == static_cast<int>(nodes.size());
+}
+
+void applyEdgeChangesToDistanceMatrix(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion) {
+    int n = distanceMatrix.nodeCount;
+    if (!distanceMatrix.valid || distanceMatrix.builtForVersion != previousVersion ||
+        n != static_cast<int>(nodes.size())) {
+        return;   // Already stale, the next ensureDistanceMatrix() rebuilds it
+    }
+
+    const CSRGraph& graph = getCSRGraph();
+    double* dist = distanceMatrix.dist.data();
+    int* hop = distanceMatrix.nextHop.data();
+
+    // 1. Cheaper edges, one at a time: d(s, t) = min(d(s, t), d(s, u) + w + d(v, t))
+    for (const EdgeWeightChange& c : changes) {
+        if (c.newWeight >= c.oldWeight) continue;
+        int u = c.from;
+        int v = graph.targets[c.edge];
+        const double* fromV = dist + static_cast<size_t>(v) * n;
+
+        for (int s = 0; s < n; ++s) {
+            double* row = dist + static_cast<size_t>(s) * n;
+            int* hopRow = hop + static_cast<size_t>(s) * n;
+            double viaEdge = row[u] + c.newWeight;
+            if (viaEdge == INF_DIST || viaEdge >= row[v]) continue;
+
+            int firstHop = (s == u) ? v : hopRow[u];
+            for (int t = 0; t < n; ++t) {
+                double candidate = viaEdge + fromV[t];
+                if (candidate < row[t]) {
+                    row[t] = candidate;
+                    hopRow[t] = firstHop;
+                }
+            }
+        }
+    }
+
+    // 2. Dearer edges only matter to sources whose shortest paths used them
+    std::vector<char> dirty(n, 0);
+    for (const EdgeWeightChange& c : changes) {
+        if (c.newWeight <= c.oldWeight) continue;
+        int u = c.from;
+        int v = graph.targets[c.edge];
+        for (int s = 0; s < n; ++s) {
+            const double* row = dist + static_cast<size_t>(s) * n;
+            if (row[u] == INF_DIST || row[v] == INF_DIST) continue;
+            if (row[u] + c.oldWeight <= row[v] * (1.0 + 1e-12)) {
+                dirty[s] = 1;
+            }
+        }
+    }
+
+    int recomputed = 0;
+    for (int s = 0; s < n; ++s) {
+        if (!dirty[s]) continue;
+        double* row = dist + static_cast<size_t>(s) * n;
+        int* hopRow = hop + static_cast<size_t>(s) * n;
+        std::fill(row, row + n, INF_DIST);
+        std::fill(hopRow, hopRow + n, -1);
+        computeRow(graph, s, row, hopRow);
+        ++recomputed;
+    }
+
+    distanceMatrix.builtForVersion = graphVersion;
+
+    if (recomputed > 0) {
+        std::cerr << "[DISTANCE] Recomputed " << recomputed << "/" << n << " rows after graph change\n";
+    }
+}
+
+static bool validNode(int node) {
+    return node >= 0 && node < static_cast<int>(nodes.size());
+}
+
+double getCachedDistance(int fromNode, int toNode) {
+    if (!validNode(fromNode) || !validNode(toNode)) {
+        return INF_DIST;
+    }
+
+    if (ensureDistanceMatrix()) {
+        return distanceMatrix.getDistance(fromNode, toNode);
+    }
+
+    return findShortestPathBidirectional(fromNode, toNode).getTotalDistance();
+}
+
+int getNextHop(int fromNode, int toNode) {
+    if (!validNode(fromNode) || !validNode(toNode)) {
+        return -1;
+    }
+
+    if (ensureDistanceMatrix()) {
+        return distanceMatrix.getNextHop(fromNode, toNode);
+    }
+
+    Path path = findShortestPathBidirectional(fromNode, toNode);
+    if (!path.isFound()) return -1;
+    return path.getNodeCount() > 1 ? path.getNode(1) : fromNode;
+}
+
+Path getCachedPath(int fromNode, int toNode) {
+    if (!validNode(fromNode) || !validNode(toNode) || !ensureDistanceMatrix()) {
+        return findShortestPathBidirectional(fromNode, toNode);
+    }
+
+    Path path;
+    path.found = false;
+    path.totalDistance = distanceMatrix.getDistance(fromNode, toNode);
+
+    if (distanceMatrix.getNextHop(fromNode, toNode) == -1) {
+        return path;
+    }
+
+    int current = fromNode;
+    path.nodes.push_back(current);
+    while (current != toNode) {
+        current = distanceMatrix.getNextHop(current, toNode);
+        path.nodes.push_back(current);
+    }
+
+    path.found = true;
+    return path;
+}
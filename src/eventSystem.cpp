@@ -1,12 +1,33 @@
 #include <iostream>
 #include <cmath>
+#include <deque>
 #include "../includes/eventSystem.hpp"
 #include "../includes/hotWarmCold.hpp"
 #include "../includes/jsonComm.hpp"
+#include "../includes/weightedSampler.hpp"
+#include "../includes/inventoryIndex.hpp"
+#include "../includes/robot.hpp"
 
-static std::map<int, int> postponeCount;
-static std::map<int, double> lastPostponeTime;
-std::priority_queue<SimEvent, std::vector<SimEvent>, std::greater<SimEvent>> eventQueue;
+// En order som väntar på att produkten fylls på
+struct Backorder {
+    SimEvent order;
+    double deadline;
+    long long serial;
+    TimerHandle timer;   // Cancels the order at the deadline
+};
+
+// Väntande ordrar per produkt, äldst först
+static std::map<int, std::deque<Backorder>> backorders;
+static long long backorderSerial = 0;
+
+// Högst en väntande brådskande påfyllning per produkt
+static std::map<int, EventHandle> urgentRestocks;
+
+// Batterikontroll per robot (index)
+static std::map<int, TimerHandle> batteryWatches;
+
+CalendarQueue<SimEvent> eventQueue;
+TimerWheel<SimTimer> simTimers(1.0);
 std::mt19937 rng;
 double currentSimTime = 0.0;
 
@@ -14,6 +35,10 @@ double currentSimTime = 0.0;
 static int totalDeliveries = 0;
 static int totalOrders = 0;
 static int totalRestockChecks = 0;
+static int totalBackorders = 0;
+static int totalBackordersReleased = 0;
+static int totalBackordersCancelled = 0;
+static int totalTasksExpired = 0;
 static std::vector<double> deliveryIntervals;
 static std::vector<double> orderIntervals;
 static double lastDeliveryTime = 0.0;
@@ -22,6 +47,52 @@ static double lastOrderTime = 0.0;
 // Task ID counter
 static int taskIdCounter = 0;
 
+// Uppgiftens deadline: satt vid första försöket och kvar genom alla omförsök
+static double taskDeadline(const SimEvent& event, double timeAllowed) {
+    return event.getDeadline() >= 0.0 ? event.getDeadline() : currentSimTime + timeAllowed;
+}
+
+static bool missesDeadline(const SimEvent& event, double retryTime) {
+    if (event.getDeadline() < 0.0 || retryTime <= event.getDeadline()) return false;
+    
+    std::cerr << "[DEADLINE] " << event.getTypeString() << " for Product " << event.getProductID()
+              << " given up - a retry at " << retryTime << "s would miss the deadline ("
+              << event.getDeadline() << "s)\n";
+    totalTasksExpired++;
+    return true;
+}
+
+// Schemalägg ett nytt försök, om det hinns med före deadline
+static void scheduleRetry(const SimEvent& event, double retryTime) {
+    if (missesDeadline(event, retryTime)) return;
+    
+    SimEvent retry = event;
+    retry.setTriggerTime(retryTime);
+    eventQueue.push(retry);
+}
+
+// Schemalägg en brådskande påfyllning, om det inte redan finns en för produkten
+static void requestUrgentRestock(int productId, int quantity, double time, double deadline = -1.0) {
+    EventHandle& handle = urgentRestocks[productId];
+    if (eventQueue.isPending(handle)) {
+        if (time < eventQueue.get(handle).getTriggerTime()) {
+            eventQueue.reschedule(handle, time);
+        }
+        return;
+    }
+    
+    SimEvent urgentRestock;
+    urgentRestock.setType(EventType::UrgentRestock);
+    urgentRestock.setTriggerTime(time);
+    urgentRestock.setNodeIndex(-1);
+    urgentRestock.setProductID(productId);
+    urgentRestock.setQuantity(quantity);
+    urgentRestock.setDeadline(deadline);
+    if (missesDeadline(urgentRestock, time)) return;
+    
+    handle = eventQueue.schedule(urgentRestock);
+}
+
 void handleUrgentRestock(const SimEvent& event) {
     std::cerr << "[URGENT-RESTOCK] Handling urgent restock for Product " 
               << event.getProductID() << "\n";
@@ -29,34 +100,19 @@ void handleUrgentRestock(const SimEvent& event) {
     auto* dockData = nodes[loadingDockNode].getLoadingDock();
     if (!dockData) return;
     
+    double deadline = taskDeadline(event, 180.0);  // 3 minuter
+    
     // Om dock är upptagen, schemalägg om direkt
     if (dockData->getIsOccupied()) {
         std::cerr << "[URGENT-RESTOCK] Loading dock busy - Rescheduling in 30s\n";
-        SimEvent retry = event;
-        retry.setTriggerTime(currentSimTime + 30.0);
-        eventQueue.push(retry);
+        requestUrgentRestock(event.getProductID(), event.getQuantity(), currentSimTime + 30.0, deadline);
         return;
     }
     
     // Hitta vilken hylla som har denna produkt (för att restock till samma plats)
-    int targetShelfNode = -1;
-    
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].getType() != NodeType::Shelf) continue;
-        
-        auto* shelfData = nodes[i].getShelf();
-        if (!shelfData) continue;
-        
-        for (int j = 0; j < shelfData->getSlotCount(); ++j) {
-            Slot slot = shelfData->getSlot(j);
-            if (slot.getProductID() == event.getProductID()) {
-                targetShelfNode = i;
-                break;
-            }
-        }
-        
-        if (targetShelfNode != -1) break;
-    }
+    const std::vector<SlotRef>& productSlots = getProductSlots(event.getProductID());
+    int targetShelfNode = productSlots.empty() ? -1 : productSlots.front().node;
+    int targetSlotIndex = productSlots.empty() ? -1 : productSlots.front().slot;
     
     if (targetShelfNode == -1) {
         std::cerr << "[ERROR] No shelf found for Product " 
@@ -79,7 +135,7 @@ void handleUrgentRestock(const SimEvent& event) {
         task.sourceNode = loadingDockNode;
         task.targetNode = targetShelfNode;
         task.priority = "urgent";
-        task.deadline = currentSimTime + 180.0;  // 3 minuter
+        task.deadline = deadline;
         
         globalJsonComm->sendNewTask(task, currentSimTime);
         Action action = globalJsonComm->receiveAction();
@@ -91,14 +147,7 @@ void handleUrgentRestock(const SimEvent& event) {
             // Uppdatera lagret
             auto* shelfData = nodes[targetShelfNode].getShelf();
             if (shelfData) {
-                int slotIndex = -1;
-                for (int j = 0; j < shelfData->getSlotCount(); ++j) {
-                    Slot slot = shelfData->getSlot(j);
-                    if (slot.getProductID() == event.getProductID()) {
-                        slotIndex = j;
-                        break;
-                    }
-                }
+                int slotIndex = targetSlotIndex;
                 
                 if (slotIndex != -1) {
                     Slot slot = shelfData->getSlot(slotIndex);
@@ -111,6 +160,8 @@ void handleUrgentRestock(const SimEvent& event) {
                     std::cerr << "[URGENT-RESTOCK] Restocked " 
                               << event.getQuantity() << " units - "
                               << slot.getOccupied() << " -> " << newOccupied << "\n";
+                    
+                    releaseBackorders(event.getProductID());
                 }
             }
             
@@ -121,9 +172,7 @@ void handleUrgentRestock(const SimEvent& event) {
             std::cerr << "[URGENT-RESTOCK] RL rejected - Rescheduling in 60s\n";
             dockData->setIsOccupied(false);
             
-            SimEvent retry = event;
-            retry.setTriggerTime(currentSimTime + 60.0);
-            eventQueue.push(retry);
+            requestUrgentRestock(event.getProductID(), event.getQuantity(), currentSimTime + 60.0, deadline);
         }
     }
 }
@@ -133,16 +182,24 @@ void initEventSystem(unsigned int seed) {
     currentSimTime = 0.0;
     taskIdCounter = 0;
     
-    // Rensa event queue
-    while (!eventQueue.empty()) eventQueue.pop();
+    // Rensa event queue och timers
+    eventQueue.clear();
+    simTimers.clear(0.0);
+    backorders.clear();
+    urgentRestocks.clear();
+    batteryWatches.clear();
     
     // Återställ statistik
     EventSystemAccess::resetEventStats();
     
+    // Efterfrågan utgår från produkternas aktuella popularitet
+    rebuildProductDemand();
+    
     // Schemalägg första event av varje typ
     generateIncomingDelivery(0.0);
     generateCustomerOrder(0.0);
     scheduleRestockCheck(0.0);
+    simTimers.schedule(getNextDecayTime(), SimTimer{TimerType::PopularityDecay, -1, 0});
 }
 
 void generateIncomingDelivery(double currentTime, double avgIntervalHours) {
@@ -159,13 +216,9 @@ void generateIncomingDelivery(double currentTime, double avgIntervalHours) {
         case 2: lorrySize = Lorry::BIG_LORRY; break;
     }
     
-    // Slumpa vilken produkt som levereras (populära produkter beställs oftare)
-    std::vector<double> weights;
-    for (const auto& p : products) {
-        weights.push_back(std::max(1, 10 - p.getPopularity()));
-    }
-    std::discrete_distribution<> prodDist(weights.begin(), weights.end());
-    int productIdx = prodDist(rng);
+    // Slumpa vilken produkt som levereras (impopulära produkter levereras oftare)
+    int productIdx = sampleDeliveryProductIndex(rng);
+    if (productIdx < 0) return;
     
     SimEvent event;
     event.setType(EventType::IncomingDelivery);
@@ -182,12 +235,8 @@ void generateCustomerOrder(double currentTime, double avgIntervalMinutes) {
     double nextTime = currentTime + dist(rng);
     
     // Populära produkter beställs oftare (Hot zone bias)
-    std::vector<double> weights;
-    for (const auto& p : products) {
-        weights.push_back(p.getPopularity() + 1);
-    }
-    std::discrete_distribution<> prodDist(weights.begin(), weights.end());
-    int productIdx = prodDist(rng);
+    int productIdx = sampleOrderProductIndex(rng);
+    if (productIdx < 0) return;
     
     // Slumpa antal (1-5 items)
     std::uniform_int_distribution<> qtyDist(1, 5);
@@ -203,14 +252,7 @@ void generateCustomerOrder(double currentTime, double avgIntervalMinutes) {
 }
 
 void scheduleRestockCheck(double currentTime) {
-    SimEvent event;
-    event.setType(EventType::RestockNeeded);
-    event.setTriggerTime(currentTime + 1800); // 30 min
-    event.setNodeIndex(-1);
-    event.setProductID(-1);
-    event.setQuantity(0);
-    
-    eventQueue.push(event);
+    simTimers.schedule(currentTime + RESTOCK_CHECK_INTERVAL, SimTimer{TimerType::RestockSweep, -1, 0});
 }
 
 void handleIncomingDelivery(const SimEvent& event) {
@@ -226,12 +268,14 @@ void handleIncomingDelivery(const SimEvent& event) {
     auto* dockData = nodes[loadingDockNode].getLoadingDock();
     if (!dockData) return;
     
+    // Leveransen ska vara avklarad inom 10 minuter från ankomsten
+    SimEvent delivery = event;
+    delivery.setDeadline(taskDeadline(event, 600.0));
+    
     if (dockData->getIsOccupied()) 
     {
         // Lastbil måste vänta - återschemalägg om 5 minuter
-        SimEvent retry = event;
-        retry.setTriggerTime(currentSimTime + 300.0);
-        eventQueue.push(retry);
+        scheduleRetry(delivery, currentSimTime + 300.0);
         return;
     }
     
@@ -254,7 +298,7 @@ void handleIncomingDelivery(const SimEvent& event) {
         task.sourceNode = loadingDockNode;
         task.targetNode = -1; // RL väljer hylla
         task.priority = "normal";
-        task.deadline = currentSimTime + 600.0; // 10 minuter
+        task.deadline = delivery.getDeadline();
         
         // Skicka till RL
         globalJsonComm->sendNewTask(task, currentSimTime);
@@ -270,14 +314,7 @@ void handleIncomingDelivery(const SimEvent& event) {
         // Uppdatera hyllans lager
         auto* shelfData = nodes[action.targetNode].getShelf();
         if (shelfData) {
-            int slotIndex = -1;
-            for (int j = 0; j < shelfData->getSlotCount(); ++j) {
-                Slot slot = shelfData->getSlot(j);
-                if (slot.getProductID() == event.getProductID()) {
-                    slotIndex = j;
-                    break;
-                }
-            }
+            int slotIndex = findProductSlotOnShelf(event.getProductID(), action.targetNode);
             
             if (slotIndex != -1) {
                 Slot slot = shelfData->getSlot(slotIndex);
@@ -292,6 +329,8 @@ void handleIncomingDelivery(const SimEvent& event) {
                         << " Slot " << slotIndex 
                         << " Product " << event.getProductID()
                         << ": " << slot.getOccupied() << " -> " << newOccupied << "\n";
+                
+                releaseBackorders(event.getProductID());
             } else {
                 std::cerr << "[ERROR] Product " << event.getProductID() 
                         << " not found on target shelf!\n";
@@ -309,110 +348,50 @@ void handleIncomingDelivery(const SimEvent& event) {
             dockData->setIsOccupied(false);
             
             // Återschemalägg om 2 minuter
-            SimEvent retry = event;
-            retry.setTriggerTime(currentSimTime + 120.0);
-            eventQueue.push(retry);
+            scheduleRetry(delivery, currentSimTime + 120.0);
         }
     }
 
     generateIncomingDelivery(currentSimTime);
 }
 
-void handleCustomerOrder(const SimEvent& event) {
-    // Tracking
-    if (lastOrderTime > 0.0) {
-        orderIntervals.push_back(event.getTriggerTime() - lastOrderTime);
-    }
-    lastOrderTime = event.getTriggerTime();
-    totalOrders++;
-    
-    auto* deskData = nodes[frontDeskNode].getFrontDesk();
-    if (!deskData) return;
-    
-    deskData->setPendingOrders(deskData->getPendingOrders() + 1);
-    
-    std::cerr << "[ORDER] Customer ordered Product " << event.getProductID() 
-              << " x" << event.getQuantity() << " at Front Desk\n";
-    
-    // Kolla om ordern har försökt för många gånger
+// Parkera en order som inte kan levereras tills produkten fylls på
+static void parkBackorder(const SimEvent& event) {
     int productId = event.getProductID();
-    if (postponeCount[productId] >= 10) {
-        std::cerr << "[ORDER] CANCELLED - Product " << productId 
-                  << " unavailable after " << postponeCount[productId] 
-                  << " attempts\n";
-        
-        postponeCount[productId] = 0;
-        deskData->setPendingOrders(deskData->getPendingOrders() - 1);
-        generateCustomerOrder(currentSimTime);
-        return;
+    std::deque<Backorder>& queue = backorders[productId];
+    bool firstWaiting = queue.empty();
+    
+    double deadline = currentSimTime + BACKORDER_TIMEOUT;
+    long long serial = backorderSerial++;
+    TimerHandle timer = simTimers.schedule(deadline, SimTimer{TimerType::BackorderDeadline, productId, serial});
+    queue.push_back({event, deadline, serial, timer});
+    totalBackorders++;
+    
+    std::cerr << "[BACKORDER] Product " << productId 
+              << " x" << event.getQuantity() 
+              << " NOT AVAILABLE - Waiting for restock (" << queue.size() 
+              << " waiting, deadline " << queue.back().deadline << "s)\n";
+    
+    // Första väntande ordern begär en brådskande påfyllning
+    if (firstWaiting) {
+        std::cerr << "[URGENT] Product " << productId 
+                  << " is backordered - Scheduling URGENT restock event\n";
+        requestUrgentRestock(productId, 30, currentSimTime + 1.0);
     }
-    
-    // Hitta produkten på hyllan
-    int availableQuantity = 0;
-    int sourceShelfNode = -1;
-    int sourceSlotIndex = -1;
+}
 
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].getType() != NodeType::Shelf) continue;
-        
-        auto* shelfData = nodes[i].getShelf();
-        if (!shelfData) continue;
-        
-        for (int j = 0; j < shelfData->getSlotCount(); ++j) {
-            Slot slot = shelfData->getSlot(j);
-            
-            if (slot.getProductID() == event.getProductID() && 
-                slot.getOccupied() >= event.getQuantity()) {
-                availableQuantity = slot.getOccupied();
-                sourceShelfNode = i;
-                sourceSlotIndex = j;
-                break;
-            }
-        }
-        
-        if (sourceShelfNode != -1) break;
-    }
+// Reservera varorna på 'source' och skicka ordern till RL-agenten
+static void dispatchOrder(const SimEvent& event, const SlotRef& source) {
+    auto* deskData = nodes[frontDeskNode].getFrontDesk();
+    if (!deskData) return;
     
-    // Om produkten INTE finns
-    if (sourceShelfNode == -1) {
-        postponeCount[productId]++;
-        lastPostponeTime[productId] = currentSimTime;
-        
-        int attempts = postponeCount[productId];
-        double delay = 30.0 * std::pow(2.0, std::min(attempts - 1, 4));
-        
-        std::cerr << "[ORDER] Product " << productId 
-                  << " x" << event.getQuantity() 
-                  << " NOT AVAILABLE (attempt " << attempts 
-                  << ") - Postponing for " << delay << "s\n";
-        
-        if (attempts == 3) {
-            std::cerr << "[URGENT] Product " << productId 
-                      << " postponed " << attempts 
-                      << " times - Scheduling URGENT restock event\n";
-            
-            SimEvent urgentRestock;
-            urgentRestock.setType(EventType::UrgentRestock);
-            urgentRestock.setTriggerTime(currentSimTime + 1.0);
-            urgentRestock.setNodeIndex(-1);
-            urgentRestock.setProductID(productId);
-            urgentRestock.setQuantity(30);
-            
-            eventQueue.push(urgentRestock);
-        }
-        
-        // Återschemalägg order med exponentiell backoff
-        SimEvent retry = event;
-        retry.setTriggerTime(currentSimTime + delay);
-        eventQueue.push(retry);
-        
-        deskData->setPendingOrders(deskData->getPendingOrders() - 1);
-        generateCustomerOrder(currentSimTime);
-        return;
-    }
+    int sourceShelfNode = source.node;
+    int sourceSlotIndex = source.slot;
     
-    // Produkten finns! Nollställ postpone counter
-    postponeCount[productId] = 0;
+    // Nya försök går förbi ankomstbokföringen i handleCustomerOrder
+    SimEvent order = event;
+    order.setType(EventType::OrderRetry);
+    order.setDeadline(taskDeadline(event, 300.0));
     
     // RESERVERA produkten INNAN RL-call
     auto* shelfData = nodes[sourceShelfNode].getShelf();
@@ -422,11 +401,8 @@ void handleCustomerOrder(const SimEvent& event) {
         
         if (newOccupied < 0) {
             std::cerr << "[ERROR] Race condition detected! Postponing.\n";
-            SimEvent retry = event;
-            retry.setTriggerTime(currentSimTime + 10.0);
-            eventQueue.push(retry);
+            scheduleRetry(order, currentSimTime + 10.0);
             deskData->setPendingOrders(deskData->getPendingOrders() - 1);
-            generateCustomerOrder(currentSimTime);
             return;
         }
         
@@ -451,7 +427,7 @@ void handleCustomerOrder(const SimEvent& event) {
         task.sourceNode = sourceShelfNode;
         task.targetNode = frontDeskNode;
         task.priority = "normal";
-        task.deadline = currentSimTime + 300.0;
+        task.deadline = order.getDeadline();
         
         globalJsonComm->sendNewTask(task, currentSimTime);
         Action action = globalJsonComm->receiveAction();
@@ -477,16 +453,174 @@ void handleCustomerOrder(const SimEvent& event) {
                           << (slot.getOccupied() + event.getQuantity()) << "\n";
             }
             
-            SimEvent retry = event;
-            retry.setTriggerTime(currentSimTime + 30.0);
-            eventQueue.push(retry);
+            scheduleRetry(order, currentSimTime + 30.0);
             deskData->setPendingOrders(deskData->getPendingOrders() - 1);
         }
     }
+}
+
+// Hitta produkten på hyllan. Finns den inte väntar ordern i kön tills
+// en påfyllning kommer (eller deadline passerar)
+static void placeOrder(const SimEvent& event) {
+    auto* deskData = nodes[frontDeskNode].getFrontDesk();
+    if (!deskData) return;
+    
+    releaseBackorders(event.getProductID());
+    
+    SlotRef source;
+    if (!backorders[event.getProductID()].empty() ||
+        !findSlotWithStock(event.getProductID(), event.getQuantity(), source)) {
+        parkBackorder(event);
+        deskData->setPendingOrders(deskData->getPendingOrders() - 1);
+    } else {
+        dispatchOrder(event, source);
+    }
+}
+
+void handleCustomerOrder(const SimEvent& event) {
+    // Tracking
+    if (lastOrderTime > 0.0) {
+        orderIntervals.push_back(event.getTriggerTime() - lastOrderTime);
+    }
+    lastOrderTime = event.getTriggerTime();
+    totalOrders++;
+    
+    auto* deskData = nodes[frontDeskNode].getFrontDesk();
+    if (!deskData) return;
+    
+    deskData->setPendingOrders(deskData->getPendingOrders() + 1);
+    
+    std::cerr << "[ORDER] Customer ordered Product " << event.getProductID() 
+              << " x" << event.getQuantity() << " at Front Desk\n";
+    
+    placeOrder(event);
     
     generateCustomerOrder(currentSimTime);
 }
 
+void handleOrderRetry(const SimEvent& event) {
+    auto* deskData = nodes[frontDeskNode].getFrontDesk();
+    if (!deskData) return;
+    
+    deskData->setPendingOrders(deskData->getPendingOrders() + 1);
+    
+    std::cerr << "[ORDER] Retrying Product " << event.getProductID() 
+              << " x" << event.getQuantity() << "\n";
+    
+    placeOrder(event);
+}
+
+void releaseBackorders(int productID) {
+    auto it = backorders.find(productID);
+    if (it == backorders.end()) return;
+    
+    auto* deskData = nodes[frontDeskNode].getFrontDesk();
+    if (!deskData) return;
+    
+    // Först in, först ut: en order som inte ryms håller kvar de bakom sig
+    std::deque<Backorder>& queue = it->second;
+    SlotRef source;
+    while (!queue.empty() &&
+           findSlotWithStock(productID, queue.front().order.getQuantity(), source)) {
+        SimEvent order = queue.front().order;
+        simTimers.cancel(queue.front().timer);
+        queue.pop_front();
+        totalBackordersReleased++;
+        
+        std::cerr << "[BACKORDER] Product " << productID << " x" << order.getQuantity() 
+                  << " back in stock - Releasing order (" << queue.size() << " still waiting)\n";
+        
+        deskData->setPendingOrders(deskData->getPendingOrders() + 1);
+        dispatchOrder(order, source);
+    }
+}
+
+// Ordern har väntat för länge - avbryt den
+static void expireBackorder(int productId, long long serial) {
+    auto it = backorders.find(productId);
+    if (it == backorders.end()) return;
+    
+    // Kön är sorterad på deadline, så ordern står nästan alltid först
+    std::deque<Backorder>& queue = it->second;
+    for (auto order = queue.begin(); order != queue.end(); ++order) {
+        if (order->serial != serial) continue;
+        
+        std::cerr << "[ORDER] CANCELLED - Product " << productId 
+                  << " x" << order->order.getQuantity()
+                  << " not restocked within " << BACKORDER_TIMEOUT << "s\n";
+        bool wasHead = order == queue.begin();
+        queue.erase(order);
+        totalBackordersCancelled++;
+        
+        // Ordern höll kvar de bakom sig - de kan rymmas nu
+        if (wasHead) {
+            releaseBackorders(productId);
+        }
+        return;
+    }
+}
+
+// Skicka LOW_BATTERY för en ledig robot med lågt batteri; sant om den ska kollas igen
+static bool checkBattery(int robotIdx) {
+    if (robotIdx < 0 || robotIdx >= static_cast<int>(robots.size())) return false;
+    
+    Robot& robot = robots[robotIdx];
+    if (!robot.needsCharging(20.0) || !robot.isIdle()) return false;
+    
+    std::cerr << "[ROBOT] " << robot.getId() 
+              << " needs charging (battery: " << robot.getBattery() << "%)\n";
+    
+    if (globalJsonComm) {
+        globalJsonComm->sendRobotStatus(
+            robotIdx, 
+            StatusType::LOW_BATTERY, 
+            "", 
+            currentSimTime,
+            "Battery low, requesting charge"
+        );
+    }
+    return true;
+}
+
+void startBatteryWatch(int robotIdx) {
+    TimerHandle& watch = batteryWatches[robotIdx];
+    if (simTimers.isPending(watch)) return;
+    
+    if (checkBattery(robotIdx)) {
+        watch = simTimers.schedule(currentSimTime + BATTERY_CHECK_INTERVAL,
+                                   SimTimer{TimerType::BatteryCheck, robotIdx, 0});
+    }
+}
+
+static void handleTimer(const SimTimer& timer) {
+    switch (timer.type) {
+        case TimerType::RestockSweep: {
+            SimEvent check;
+            check.setType(EventType::RestockNeeded);
+            check.setTriggerTime(currentSimTime);
+            check.setNodeIndex(-1);
+            check.setProductID(-1);
+            check.setQuantity(0);
+            handleRestockNeeded(check);
+            break;
+        }
+        case TimerType::PopularityDecay:
+            applyPopularityDecay(currentSimTime);
+            simTimers.schedule(getNextDecayTime(), SimTimer{TimerType::PopularityDecay, -1, 0});
+            break;
+        case TimerType::BatteryCheck:
+            // Roboten är fortfarande ledig och låg - påminn igen
+            if (checkBattery(timer.target)) {
+                batteryWatches[timer.target] = simTimers.schedule(
+                    currentSimTime + BATTERY_CHECK_INTERVAL, SimTimer{TimerType::BatteryCheck, timer.target, 0});
+            }
+            break;
+        case TimerType::BackorderDeadline:
+            expireBackorder(timer.target, timer.tag);
+            break;
+    }
+}
+
 void handleRestockNeeded(const SimEvent& event) {
     totalRestockChecks++;
     
@@ -565,8 +699,13 @@ void handleRestockNeeded(const SimEvent& event) {
 void processEvents(double deltaTime) {
     currentSimTime += deltaTime;
     
-    // Apply popularity decay
-    applyPopularityDecay(currentSimTime);
+    // Periodiska timers och deadlines (decay, påfyllningskontroll, batteri, backorders)
+    static std::vector<SimTimer> expiredTimers;
+    expiredTimers.clear();
+    simTimers.advance(currentSimTime, expiredTimers);
+    for (const SimTimer& timer : expiredTimers) {
+        handleTimer(timer);
+    }
     
     // Bearbeta alla events som ska triggas nu
     while (!eventQueue.empty() && eventQueue.top().getTriggerTime() <= currentSimTime) {
@@ -586,6 +725,9 @@ void processEvents(double deltaTime) {
             case EventType::UrgentRestock:
                 handleUrgentRestock(event);
                 break;
+            case EventType::OrderRetry:
+                handleOrderRetry(event);
+                break;
             default:
                 break;
         }
@@ -606,6 +748,14 @@ namespace EventSystemAccess {
         return static_cast<int>(eventQueue.size());
     }
     
+    int getBackorderCount() {
+        int waiting = 0;
+        for (const auto& entry : backorders) {
+            waiting += static_cast<int>(entry.second.size());
+        }
+        return waiting;
+    }
+    
     bool hasNextEvent() {
         return !eventQueue.empty();
     }
@@ -617,6 +767,13 @@ namespace EventSystemAccess {
         return -1.0;
     }
     
+    double getNextTimerTime() {
+        if (!simTimers.empty()) {
+            return simTimers.getNextExpiry();
+        }
+        return -1.0;
+    }
+    
     SimEvent peekNextEvent() {
         if (!eventQueue.empty()) {
             return eventQueue.top();
@@ -635,6 +792,10 @@ namespace EventSystemAccess {
         stats.totalDeliveries = totalDeliveries;
         stats.totalOrders = totalOrders;
         stats.totalRestockChecks = totalRestockChecks;
+        stats.totalBackorders = totalBackorders;
+        stats.totalBackordersReleased = totalBackordersReleased;
+        stats.totalBackordersCancelled = totalBackordersCancelled;
+        stats.totalTasksExpired = totalTasksExpired;
         
         // Beräkna genomsnittliga intervall
         if (!deliveryIntervals.empty()) {
@@ -664,6 +825,10 @@ namespace EventSystemAccess {
         totalDeliveries = 0;
         totalOrders = 0;
         totalRestockChecks = 0;
+        totalBackorders = 0;
+        totalBackordersReleased = 0;
+        totalBackordersCancelled = 0;
+        totalTasksExpired = 0;
         deliveryIntervals.clear();
         orderIntervals.clear();
         lastDeliveryTime = 0.0;
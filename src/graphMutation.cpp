@@ -0,0 +1,284 @@
+#include "../includes/graphMutation.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/distanceMatrix.hpp"
+#include "../includes/landmarks.hpp"
+#include "../includes/congestion.hpp"
+#include "../includes/pathCache.hpp"
+#include "../includes/reservationTable.hpp"
+#include "../includes/robot.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+static const double INF_WEIGHT = std::numeric_limits<double>::infinity();
+
+namespace {
+
+struct EdgeRef {
+    int from;
+    int index;   // adj[from][index]
+
+    bool operator<(const EdgeRef& other) const {
+        return from != other.from ? from < other.from : index < other.index;
+    }
+    bool operator==(const EdgeRef& other) const {
+        return from == other.from && index == other.index;
+    }
+};
+
+bool validNode(int node) {
+    return node >= 0 && node < static_cast<int>(nodes.size());
+}
+
+// adj entries for from -> to, plus the mirrored entries of undirected ones
+void collectEdges(int fromNode, int toNode, std::vector<EdgeRef>& out) {
+    out.clear();
+    if (!validNode(fromNode) || !validNode(toNode)) return;
+
+    for (int i = 0; i < static_cast<int>(adj[fromNode].size()); ++i) {
+        const Edge& edge = adj[fromNode][i];
+        if (edge.to != toNode) continue;
+        out.push_back({fromNode, i});
+
+        if (!edge.directed) {
+            for (int j = 0; j < static_cast<int>(adj[toNode].size()); ++j) {
+                const Edge& mirror = adj[toNode][j];
+                if (mirror.to == fromNode && !mirror.directed) {
+                    out.push_back({toNode, j});
+                }
+            }
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// Every edge into or out of 'node' (the CSR must match adj)
+void collectIncidentEdges(const CSRGraph& graph, int node, std::vector<EdgeRef>& out) {
+    out.clear();
+    for (int i = 0; i < static_cast<int>(adj[node].size()); ++i) {
+        out.push_back({node, i});
+    }
+    for (int r = graph.getRevEdgeBegin(node); r < graph.getRevEdgeEnd(node); ++r) {
+        int u = graph.revSources[r];
+        out.push_back({u, graph.revEdgeIds[r] - graph.getEdgeBegin(u)});
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void patchCSR(CSRGraph& graph, const EdgeWeightChange& change) {
+    int v = graph.targets[change.edge];
+    graph.weights[change.edge] = change.newWeight;
+    for (int r = graph.getRevEdgeBegin(v); r < graph.getRevEdgeEnd(v); ++r) {
+        if (graph.revEdgeIds[r] == change.edge) {
+            graph.revWeights[r] = change.newWeight;
+            break;
+        }
+    }
+
+    // Keep both bounds valid (they may get looser, never wrong)
+    graph.minWeight = std::min(graph.minWeight, change.newWeight);
+    double straight = std::hypot(nodes[v].getX() - nodes[change.from].getX(),
+                                 nodes[v].getY() - nodes[change.from].getY());
+    if (straight > 0.0 && change.newWeight < graph.coordinateScale * straight) {
+        graph.coordinateScale = change.newWeight / straight;
+    }
+}
+
+bool crossesAny(const Path& path, const std::vector<std::pair<int, int>>& sortedPairs) {
+    for (size_t i = 0; i + 1 < path.nodes.size(); ++i) {
+        if (std::binary_search(sortedPairs.begin(), sortedPairs.end(),
+                               std::make_pair(path.nodes[i], path.nodes[i + 1]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Drop cached paths that may no longer be shortest and carry the rest over
+void revalidatePathCache(unsigned long previousVersion, const std::vector<std::pair<int, int>>& dearer,
+                         bool anyCheaper) {
+    bool haveTable = isDistanceMatrixCurrent();
+
+    pathCache.revalidate(previousVersion, [&](const PathCacheKey& key, const Path& path) {
+        if (path.found && crossesAny(path, dearer)) return false;
+        if (!anyCheaper) return true;
+
+        // Something got cheaper: only the (unconstrained) all-pairs table can vouch for the entry
+        if (!haveTable || key.constraintHash != 0) return false;
+        double best = distanceMatrix.getDistance(key.start, key.goal);
+        if (!path.found) return best == INF_WEIGHT;
+        return best >= path.totalDistance - 1e-9 * std::max(1.0, path.totalDistance);
+    });
+}
+
+// Moving robots whose remaining route now crosses a closed edge get a new one.
+// The edge a robot is already on is left alone - it finishes that stretch.
+void replanRobots(const CSRGraph& graph) {
+    for (Robot& robot : robots) {
+        const Path* path = robot.getCurrentPath();
+        if (!robot.isMoving() || !path || !path->found) continue;
+
+        const std::vector<int>& route = path->nodes;
+        auto here = std::find(route.begin(), route.end(), robot.getCurrentNode());
+        if (here == route.end() || here + 1 == route.end() || *(here + 1) != robot.getTargetNode()) continue;
+
+        bool closed = false;
+        for (auto it = here + 1; it + 1 != route.end(); ++it) {
+            if (lightestEdgeWeight(graph, *it, *(it + 1)) == INF_WEIGHT) {
+                closed = true;
+                break;
+            }
+        }
+        if (!closed) continue;
+
+        int goal = route.back();
+        SharedPath tail = getSharedPath(robot.getTargetNode(), goal);
+        if (!tail->found) {
+            std::cerr << "[ROBOT] " << robot.getId() << " has no route to node " << goal
+                      << " after graph change\n";
+            robot.currentPath = nullptr;
+            continue;
+        }
+
+        Path rerouted;
+        rerouted.nodes.reserve(tail->nodes.size() + 1);
+        rerouted.nodes.push_back(robot.getCurrentNode());
+        rerouted.nodes.insert(rerouted.nodes.end(), tail->nodes.begin(), tail->nodes.end());
+        rerouted.totalDistance = lightestEdgeWeight(graph, robot.getCurrentNode(), robot.getTargetNode()) +
+                                 tail->totalDistance;
+        rerouted.found = true;
+        robot.currentPath = std::make_shared<const Path>(std::move(rerouted));
+
+        std::cerr << "[ROBOT] " << robot.getId() << " rerouted to node " << goal
+                  << " after graph change\n";
+    }
+}
+
+// Re-read the effective weight of each referenced edge and push every change
+// through the CSR graph and the structures derived from it
+bool commitChanges(const std::vector<EdgeRef>& refs, const char* what) {
+    CSRGraph& graph = csrGraph;
+    unsigned long previousVersion = graphVersion;
+
+    std::vector<EdgeWeightChange> changes;
+    for (const EdgeRef& ref : refs) {
+        int e = graph.getEdgeBegin(ref.from) + ref.index;
+        double weight = getEffectiveWeight(ref.from, adj[ref.from][ref.index]);
+        if (weight != graph.weights[e]) {
+            changes.push_back({ref.from, e, graph.weights[e], weight});
+        }
+    }
+    if (changes.empty()) return false;
+
+    std::vector<std::pair<int, int>> dearer;
+    bool anyCheaper = false;
+    for (const EdgeWeightChange& c : changes) {
+        patchCSR(graph, c);
+        if (c.newWeight > c.oldWeight) {
+            dearer.emplace_back(c.from, graph.targets[c.edge]);
+        } else {
+            anyCheaper = true;
+        }
+    }
+    std::sort(dearer.begin(), dearer.end());
+
+    ++graphVersion;
+    graph.builtForVersion = graphVersion;
+
+    applyEdgeChangesToDistanceMatrix(changes, previousVersion);
+    applyEdgeChangesToLandmarks(changes, previousVersion);
+    applyEdgeChangesToCongestion(changes, previousVersion);
+
+    // Edge ids are unchanged, so existing bookings stay meaningful
+    if (reservationTable.builtForVersion == previousVersion) {
+        reservationTable.builtForVersion = graphVersion;
+    }
+
+    revalidatePathCache(previousVersion, dearer, anyCheaper);
+    replanRobots(graph);
+
+    std::cerr << "[GRAPH] " << what << ": " << changes.size() << " edge weight(s) changed (epoch "
+              << graphVersion << ")\n";
+    return true;
+}
+
+bool setBlocked(int fromNode, int toNode, bool blocked) {
+    getCSRGraph();   // The CSR has to match adj before it is patched
+
+    std::vector<EdgeRef> refs;
+    collectEdges(fromNode, toNode, refs);
+    if (refs.empty()) return false;
+
+    for (const EdgeRef& ref : refs) {
+        adj[ref.from][ref.index].blocked = blocked;
+    }
+    commitChanges(refs, blocked ? "Edge blocked" : "Edge unblocked");
+    return true;
+}
+
+bool setDisabled(int node, bool disabled) {
+    if (!validNode(node)) return false;
+    const CSRGraph& graph = getCSRGraph();
+
+    std::vector<EdgeRef> refs;
+    collectIncidentEdges(graph, node, refs);
+    nodes[node].disabled = disabled;
+    commitChanges(refs, disabled ? "Node disabled" : "Node enabled");
+    return true;
+}
+
+} // namespace
+
+bool blockEdge(int fromNode, int toNode) {
+    return setBlocked(fromNode, toNode, true);
+}
+
+bool unblockEdge(int fromNode, int toNode) {
+    return setBlocked(fromNode, toNode, false);
+}
+
+bool isEdgeBlocked(int fromNode, int toNode) {
+    std::vector<EdgeRef> refs;
+    collectEdges(fromNode, toNode, refs);
+    for (const EdgeRef& ref : refs) {
+        if (ref.from == fromNode && adj[ref.from][ref.index].blocked) return true;
+    }
+    return false;
+}
+
+bool setEdgeWeight(int fromNode, int toNode, double distance) {
+    if (!(distance > 0.0) || distance == INF_WEIGHT) {
+        std::cerr << "[GRAPH] Invalid edge length " << distance << " for " << fromNode
+                  << " -> " << toNode << "\n";
+        return false;
+    }
+    getCSRGraph();
+
+    std::vector<EdgeRef> refs;
+    collectEdges(fromNode, toNode, refs);
+    if (refs.empty()) return false;
+
+    for (const EdgeRef& ref : refs) {
+        adj[ref.from][ref.index].distance = distance;
+    }
+    commitChanges(refs, "Edge length changed");
+    return true;
+}
+
+bool disableNode(int node) {
+    return setDisabled(node, true);
+}
+
+bool enableNode(int node) {
+    return setDisabled(node, false);
+}
+
+bool isNodeDisabled(int node) {
+    return validNode(node) && nodes[node].disabled;
+}
@@ -3,6 +3,7 @@
 #include "../includes/eventSystem.hpp"
 #include "../includes/hotWarmCold.hpp"
 #include "../includes/logger.hpp"
+#include "../includes/distanceMatrix.hpp"
 #include <iostream>
 #include <cmath>
 #include <map>
@@ -10,14 +11,8 @@
 
 // Hjälpfunktioner
 double calculateDistance(int nodeA, int nodeB) {
-    // Simplified - skulle kunna använda Dijkstra
-    // För nu returnerar vi edge-avståndet direkt om det finns
-    for (const auto& edge : adj[nodeA]) {
-        if (edge.to == nodeB) {
-            return edge.distance;
-        }
-    }
-    return 100.0; // Large distance if no direct edge
+    // Kortaste vägen ur all-pairs-tabellen (infinity om noden inte går att nå)
+    return getCachedDistance(nodeA, nodeB);
 }
 
 bool isRobotAtNode(int robotIdx, int nodeIdx) {
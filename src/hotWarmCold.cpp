@@ -3,6 +3,8 @@
 #include <cmath>
 #include "../includes/hotWarmCold.hpp"
 #include "../includes/datatypes.hpp"
+#include "../includes/weightedSampler.hpp"
+#include "../includes/inventoryIndex.hpp"
 
 // Decay configuration
 const double DECAY_RATE = 0.95;  // 5% decay per interval
@@ -23,6 +25,7 @@ void updatePopularityAndZone(int productID) {
         int currentPop = it->getPopularity();
         it->setPopularity(currentPop + static_cast<int>(POPULARITY_INCREMENT));
         int newPop = it->getPopularity();
+        updateProductDemand(static_cast<size_t>(it - products.begin()));
         
         // 3. Logik för Hot/Warm/Cold klassificering
         Zone recommendedZone;
@@ -75,7 +78,8 @@ void applyPopularityDecay(double currentTime) {
     
     int productsDecayed = 0;
     
-    for (auto& product : products) {
+    for (size_t i = 0; i < products.size(); ++i) {
+        Product& product = products[i];
         int oldPop = product.getPopularity();
         
         if (oldPop > 0) {
@@ -86,6 +90,7 @@ void applyPopularityDecay(double currentTime) {
             
             if (newPop != oldPop) {
                 product.setPopularity(newPop);
+                updateProductDemand(i);
                 productsDecayed++;
                 
                 std::cerr << "[DECAY]   " << product.getName() 
@@ -110,33 +115,18 @@ double getDecayInterval() {
     return decayInterval;
 }
 
+double getNextDecayTime() {
+    return lastDecayTime + decayInterval;
+}
+
 void resetDecayTimer() {
     lastDecayTime = 0.0;
 }
 
 int findProductPrimaryShelf(int productID) {
-    int maxQuantity = 0;
-    int primaryShelf = -1;
-    
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].getType() != NodeType::Shelf) continue;
-        
-        const Shelf* shelf = nodes[i].getShelf();
-        if (!shelf) continue;
-        
-        for (int j = 0; j < shelf->getSlotCount(); ++j) {
-            Slot slot = shelf->getSlot(j);
-            if (slot.getProductID() == productID) {
-                int quantity = slot.getOccupied();
-                if (quantity > maxQuantity) {
-                    maxQuantity = quantity;
-                    primaryShelf = i;
-                }
-            }
-        }
-    }
-    
-    return primaryShelf;
+    // The shelf holding the most units
+    SlotRef fullest;
+    return findFullestSlot(productID, fullest) ? fullest.node : -1;
 }
 
 std::string zoneToString(Zone zone) {
@@ -3,10 +3,12 @@
 #include "../includes/robot.hpp"
 #include "../includes/hotWarmCold.hpp"
 #include "../includes/initSim.hpp"
+#include "../includes/csrGraph.hpp"
 
 int addNode(const Node& n) {
     nodes.push_back(n);
     adj.emplace_back();  
+    graphVersion++;
     return nodes.size() - 1;
 }
 
@@ -15,6 +17,7 @@ void addEdge(int from, int to, double distance, bool directed) {
     if (!directed) {
         adj[to].push_back({from, directed, distance});
     }
+    graphVersion++;
 }
 
 void assignProductToSlot(Shelf& shelf, int slotIndex, int productID, int capacity, int occupied) {
@@ -87,79 +90,79 @@ void initGraphLayout() {
     loadingDock.setDeliveryCount(0);
     loadingDock.setCurrentLorry(Lorry::MEDIUM_LORRY);
     
-    loadingDockNode = addNode(Node{ .id = "loading_dock", .type = NodeType::LoadingBay, .maxRobots = 2, .data = loadingDock });
+    loadingDockNode = addNode(Node{ .id = "loading_dock", .type = NodeType::LoadingBay, .maxRobots = 2, .data = loadingDock, .x = 0.0, .y = 0.0 });
     nodes[loadingDockNode].setZone(Zone::Other);
 
     // 2. Skapa alla hyllnoder
     Shelf shelfA; 
     shelfA.setName("Shelf A"); 
     shelfA.setSlotCount(5);
-    shelfANode = addNode(Node{ .id = "shelf_A", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfA });
+    shelfANode = addNode(Node{ .id = "shelf_A", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfA, .x = 5.0, .y = 0.0 });
     nodes[shelfANode].setZone(Zone::Hot);
 
     Shelf shelfB; 
     shelfB.setName("Shelf B"); 
     shelfB.setSlotCount(5);
-    shelfBNode = addNode(Node{ .id = "shelf_B", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfB });
+    shelfBNode = addNode(Node{ .id = "shelf_B", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfB, .x = 9.0, .y = 0.0 });
     nodes[shelfBNode].setZone(Zone::Warm);
 
     Shelf shelfC; 
     shelfC.setName("Shelf C"); 
     shelfC.setSlotCount(4);
-    shelfCNode = addNode(Node{ .id = "shelf_C", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfC });
+    shelfCNode = addNode(Node{ .id = "shelf_C", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfC, .x = 11.0, .y = -2.0 });
     nodes[shelfCNode].setZone(Zone::Cold);
 
     Shelf shelfD; 
     shelfD.setName("Shelf D"); 
     shelfD.setSlotCount(3);
-    shelfDNode = addNode(Node{ .id = "shelf_D", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfD });
+    shelfDNode = addNode(Node{ .id = "shelf_D", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfD, .x = 9.0, .y = -4.0 });
     nodes[shelfDNode].setZone(Zone::Cold);
 
     Shelf shelfE; 
     shelfE.setName("Shelf E"); 
     shelfE.setSlotCount(3);
-    shelfENode = addNode(Node{ .id = "shelf_E", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfE });
+    shelfENode = addNode(Node{ .id = "shelf_E", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfE, .x = 13.0, .y = 1.0 });
     nodes[shelfENode].setZone(Zone::Cold);
 
     Shelf shelfF; 
     shelfF.setName("Shelf F"); 
     shelfF.setSlotCount(3);
-    shelfFNode = addNode(Node{ .id = "shelf_F", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfF });
+    shelfFNode = addNode(Node{ .id = "shelf_F", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfF, .x = 13.0, .y = -6.0 });
     nodes[shelfFNode].setZone(Zone::Cold);
 
     Shelf shelfG; 
     shelfG.setName("Shelf G"); 
     shelfG.setSlotCount(2);
-    shelfGNode = addNode(Node{ .id = "shelf_G", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfG });
+    shelfGNode = addNode(Node{ .id = "shelf_G", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfG, .x = 11.0, .y = -5.0 });
     nodes[shelfGNode].setZone(Zone::Cold);
 
     Shelf shelfH; 
     shelfH.setName("Shelf H"); 
     shelfH.setSlotCount(3);
-    shelfHNode = addNode(Node{ .id = "shelf_H", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfH });
+    shelfHNode = addNode(Node{ .id = "shelf_H", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfH, .x = 9.0, .y = -8.0 });
     nodes[shelfHNode].setZone(Zone::Cold);
 
     Shelf shelfI; 
     shelfI.setName("Shelf I"); 
     shelfI.setSlotCount(2);
-    shelfINode = addNode(Node{ .id = "shelf_I", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfI });
+    shelfINode = addNode(Node{ .id = "shelf_I", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfI, .x = 6.0, .y = -9.0 });
     nodes[shelfINode].setZone(Zone::Hot);
 
     Shelf shelfJ; 
     shelfJ.setName("Shelf J"); 
     shelfJ.setSlotCount(4);
-    shelfJNode = addNode(Node{ .id = "shelf_J", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfJ });
+    shelfJNode = addNode(Node{ .id = "shelf_J", .type = NodeType::Shelf, .maxRobots = 1, .data = shelfJ, .x = 13.0, .y = -9.0 });
     nodes[shelfJNode].setZone(Zone::Warm);
 
     ChargingStation chargingStation; 
     chargingStation.setIsOccupied(0); 
     chargingStation.setChargingPorts(3);
-    chargingStationNode = addNode(Node{ .id = "charging_station", .type = NodeType::ChargingStation, .maxRobots = 3, .data = chargingStation });
+    chargingStationNode = addNode(Node{ .id = "charging_station", .type = NodeType::ChargingStation, .maxRobots = 3, .data = chargingStation, .x = 7.0, .y = 2.0 });
     nodes[chargingStationNode].setZone(Zone::Other);
 
     FrontDesk frontDesk; 
     frontDesk.setPendingOrders(0);
-    frontDeskNode = addNode(Node{ .id = "front_desk", .type = NodeType::FrontDesk, .maxRobots = 2, .data = frontDesk });
+    frontDeskNode = addNode(Node{ .id = "front_desk", .type = NodeType::FrontDesk, .maxRobots = 2, .data = frontDesk, .x = 5.0, .y = -6.0 });
     nodes[frontDeskNode].setZone(Zone::Other);
 
     // 3. Lägger till kanter
@@ -184,6 +187,9 @@ void initGraphLayout() {
     addEdge(shelfINode, frontDeskNode, 8.0, false);
     addEdge(shelfFNode, chargingStationNode, 10.0, true);
 
+    // 4. Frys grafen till CSR-form för pathfinding
+    buildCSRGraph();
+
     std::cerr << "Simulation graph layout initialized with " << nodes.size() << " nodes\n";
 }
 
@@ -0,0 +1,83 @@
+#include "../includes/inventoryIndex.hpp"
+#include <unordered_map>
+
+namespace {
+
+std::unordered_map<int, std::vector<SlotRef>> productSlots;
+unsigned long builtForLayout = 0;
+unsigned long builtForGraph = 0;
+bool built = false;
+
+void ensureIndex() {
+    if (!built || builtForLayout != slotLayoutVersion || builtForGraph != graphVersion) {
+        rebuildInventoryIndex();
+    }
+}
+
+} // namespace
+
+int SlotRef::getOccupied() const {
+    const Shelf* shelf = nodes[node].getShelf();
+    return shelf ? shelf->getSlot(slot).getOccupied() : 0;
+}
+
+void rebuildInventoryIndex() {
+    productSlots.clear();
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].getType() != NodeType::Shelf) continue;
+
+        const Shelf* shelf = nodes[i].getShelf();
+        if (!shelf) continue;
+
+        for (int j = 0; j < shelf->getSlotCount(); ++j) {
+            int productID = shelf->getSlot(j).getProductID();
+            if (productID < 0) continue;
+            productSlots[productID].push_back({static_cast<int>(i), j});
+        }
+    }
+
+    builtForLayout = slotLayoutVersion;
+    builtForGraph = graphVersion;
+    built = true;
+}
+
+const std::vector<SlotRef>& getProductSlots(int productID) {
+    static const std::vector<SlotRef> none;
+    ensureIndex();
+
+    auto it = productSlots.find(productID);
+    return it != productSlots.end() ? it->second : none;
+}
+
+bool findSlotWithStock(int productID, int quantity, SlotRef& out) {
+    for (const SlotRef& ref : getProductSlots(productID)) {
+        if (ref.getOccupied() >= quantity) {
+            out = ref;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool findFullestSlot(int productID, SlotRef& out) {
+    int mostStock = 0;
+    bool found = false;
+
+    for (const SlotRef& ref : getProductSlots(productID)) {
+        int stock = ref.getOccupied();
+        if (stock > mostStock) {
+            mostStock = stock;
+            out = ref;
+            found = true;
+        }
+    }
+    return found;
+}
+
+int findProductSlotOnShelf(int productID, int node) {
+    for (const SlotRef& ref : getProductSlots(productID)) {
+        if (ref.node == node) return ref.slot;
+    }
+    return -1;
+}
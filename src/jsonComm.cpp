@@ -3,7 +3,9 @@
 #include "../includes/robot.hpp"
 #include "../includes/logger.hpp"
 #include "../includes/helpFunctions.hpp"
+#include "../includes/distanceBatch.hpp"
 #include <fstream>
+#include <cmath>
 #include <sstream> // Behålls för att undvika kompileringsfel om den används någon annanstans
 #include <sys/select.h>
 #include <sys/time.h>
@@ -125,6 +127,25 @@ void JsonComm::sendNewTask(const Task& task, double timestamp) {
  msg["task"] = task.toJson();
  msg["state"] = buildStateJson(timestamp);
  
+ // Robot -> task source and source -> target in one batch (reverse search per
+ // target) instead of one Dijkstra per robot. Unreachable pairs become null.
+ std::vector<int> origins;
+ origins.reserve(robots.size() + 1);
+ for (const Robot& robot : robots) {
+  origins.push_back(robot.getCurrentNode());
+ }
+ origins.push_back(task.sourceNode);
+ 
+ DistanceBatch batch = computeDistanceBatch(origins, {task.sourceNode, task.targetNode});
+ json robotDistances = json::array();
+ for (size_t i = 0; i < robots.size(); ++i) {
+  double d = batch.getDistance(static_cast<int>(i), 0);
+  robotDistances.push_back(std::isfinite(d) ? json(d) : json(nullptr));
+ }
+ double routeDistance = batch.getDistance(static_cast<int>(robots.size()), 1);
+ msg["robot_distances"] = robotDistances;
+ msg["route_distance"] = std::isfinite(routeDistance) ? json(routeDistance) : json(nullptr);
+ 
  *output << msg.dump() << std::endl;
  flush();
  
@@ -358,6 +379,9 @@ json JsonComm::serializeNodes() {
   nodeJson["index"] = i;
   nodeJson["id"] = node.getId();
   nodeJson["max_robots"] = node.getMaxRobots();
+  nodeJson["x"] = node.getX();
+  nodeJson["y"] = node.getY();
+  nodeJson["disabled"] = node.isDisabled();
   
   // Type
   switch(node.getType()) {
@@ -392,6 +416,7 @@ json JsonComm::serializeEdges() {
    edgeJson["to"] = edge.to;
    edgeJson["distance"] = edge.distance;
    edgeJson["directed"] = edge.directed;
+   edgeJson["blocked"] = edge.blocked;
    edgesArray.push_back(edgeJson);
   }
  }
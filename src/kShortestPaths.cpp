@@ -0,0 +1,174 @@
+#include "../includes/kShortestPaths.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/pathConstraints.hpp"
+#include "../includes/csrGraph.hpp"
+#include <algorithm>
+#include <list>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+
+namespace {
+
+bool sameNodes(const Path& a, const Path& b) {
+    return a.nodes == b.nodes;
+}
+
+// LRU of alternative sets keyed by (start, goal), dropped whole on an epoch change.
+// The mutex guards the list, the index and the round-robin positions.
+struct AlternativeCache {
+    std::list<PathAlternatives> lru;   // Most recently used first
+    std::unordered_map<long long, std::list<PathAlternatives>::iterator> index;
+    unsigned long epoch = 0;
+    size_t capacity = DEFAULT_ALTERNATIVE_CACHE_CAPACITY;
+    std::mutex mutex;
+
+    static long long keyOf(int start, int goal) {
+        return static_cast<long long>(start) << 32 | static_cast<unsigned int>(goal);
+    }
+
+    // Called with the mutex held
+    void checkEpoch() {
+        if (epoch == graphVersion) return;
+        lru.clear();
+        index.clear();
+        epoch = graphVersion;
+    }
+};
+
+AlternativeCache alternativeCache;
+
+} // namespace
+
+std::vector<Path> findKShortestPaths(int startNode, int goalNode, int k) {
+    std::vector<Path> accepted;
+    if (k <= 0) return accepted;
+
+    // Spur searches reuse one constraint set and the thread's search workspace
+    thread_local PathConstraints constraints;
+    constraints.clear();
+
+    Path first = findConstrainedPath(startNode, goalNode, constraints);
+    if (!first.isFound()) return accepted;
+    accepted.push_back(std::move(first));
+
+    const CSRGraph& graph = getCSRGraph();
+    std::vector<Path> candidates;
+    std::vector<double> rootCost;
+
+    while (static_cast<int>(accepted.size()) < k) {
+        const std::vector<int> previous = accepted.back().nodes;
+
+        rootCost.assign(1, 0.0);
+        for (size_t i = 0; i + 1 < previous.size(); ++i) {
+            rootCost.push_back(rootCost.back() + lightestEdgeWeight(graph, previous[i], previous[i + 1]));
+        }
+
+        for (size_t i = 0; i + 1 < previous.size(); ++i) {
+            int spurNode = previous[i];
+
+            // Leave the root path's nodes out, and every next step already taken
+            // by an accepted path that shares this root
+            constraints.clear();
+            for (size_t j = 0; j < i; ++j) {
+                constraints.forbidNode(previous[j]);
+            }
+            for (const Path& path : accepted) {
+                if (path.nodes.size() > i + 1 &&
+                    std::equal(previous.begin(), previous.begin() + i + 1, path.nodes.begin())) {
+                    constraints.forbidEdge(spurNode, path.nodes[i + 1]);
+                }
+            }
+
+            Path spur = findConstrainedPath(spurNode, goalNode, constraints);
+            if (!spur.isFound()) continue;
+
+            Path candidate;
+            candidate.nodes.reserve(i + spur.nodes.size());
+            candidate.nodes.assign(previous.begin(), previous.begin() + i);
+            candidate.nodes.insert(candidate.nodes.end(), spur.nodes.begin(), spur.nodes.end());
+            candidate.totalDistance = rootCost[i] + spur.totalDistance;
+            candidate.found = true;
+
+            bool known = std::any_of(candidates.begin(), candidates.end(),
+                                     [&](const Path& p) { return sameNodes(p, candidate); });
+            if (!known) {
+                candidates.push_back(std::move(candidate));
+            }
+        }
+
+        if (candidates.empty()) break;
+
+        // Cheapest candidate next (fewer hops on ties)
+        auto best = std::min_element(candidates.begin(), candidates.end(), [](const Path& a, const Path& b) {
+            if (a.totalDistance != b.totalDistance) return a.totalDistance < b.totalDistance;
+            return a.nodes.size() < b.nodes.size();
+        });
+        accepted.push_back(std::move(*best));
+        candidates.erase(best);
+    }
+
+    return accepted;
+}
+
+// Called with alternativeCache.mutex held
+static PathAlternatives& lookupAlternatives(int startNode, int goalNode, int k) {
+    AlternativeCache& cache = alternativeCache;
+    cache.checkEpoch();
+
+    long long key = AlternativeCache::keyOf(startNode, goalNode);
+    auto it = cache.index.find(key);
+    if (it != cache.index.end()) {
+        cache.lru.splice(cache.lru.begin(), cache.lru, it->second);
+        if (it->second->requestedK >= k) {
+            return *it->second;
+        }
+    } else {
+        if (cache.lru.size() >= cache.capacity && !cache.lru.empty()) {
+            const PathAlternatives& oldest = cache.lru.back();
+            cache.index.erase(AlternativeCache::keyOf(oldest.start, oldest.goal));
+            cache.lru.pop_back();
+        }
+        cache.lru.emplace_front();
+        cache.index[key] = cache.lru.begin();
+    }
+
+    PathAlternatives& entry = cache.lru.front();
+    entry.start = startNode;
+    entry.goal = goalNode;
+    entry.requestedK = k;
+    entry.paths.clear();
+
+    for (Path& path : findKShortestPaths(startNode, goalNode, k)) {
+        if (!entry.paths.empty() && path.totalDistance > entry.paths[0]->totalDistance * ALTERNATIVE_SLACK) {
+            break;
+        }
+        entry.paths.push_back(std::make_shared<const Path>(std::move(path)));
+    }
+    return entry;
+}
+
+PathAlternatives getPathAlternatives(int startNode, int goalNode, int k) {
+    std::lock_guard<std::mutex> lock(alternativeCache.mutex);
+    return lookupAlternatives(startNode, goalNode, k);
+}
+
+SharedPath pickAlternative(int startNode, int goalNode, int k) {
+    std::lock_guard<std::mutex> lock(alternativeCache.mutex);
+    PathAlternatives& entry = lookupAlternatives(startNode, goalNode, k);
+    if (entry.paths.empty()) {
+        Path notFound;
+        notFound.found = false;
+        notFound.totalDistance = INF_DIST;
+        return std::make_shared<const Path>(std::move(notFound));
+    }
+    return entry.paths[entry.nextPick++ % entry.paths.size()];
+}
+
+void clearAlternativeCache() {
+    std::lock_guard<std::mutex> lock(alternativeCache.mutex);
+    alternativeCache.lru.clear();
+    alternativeCache.index.clear();
+}
@@ -0,0 +1,286 @@
+#include "../includes/landmarks.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <algorithm>
+
+LandmarkTable landmarkTable;
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+static const char LANDMARK_FILE_MAGIC[4] = {'A', 'L', 'T', '1'};
+
+// Full Dijkstra over the forward (d(source, v)) or reverse (d(v, source)) arrays
+static void distancesFrom(const CSRGraph& graph, int source, bool reverse, double* out) {
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+
+    const std::vector<int>& offsets = reverse ? graph.revOffsets : graph.offsets;
+    const std::vector<int>& heads = reverse ? graph.revSources : graph.targets;
+    const std::vector<double>& weights = reverse ? graph.revWeights : graph.weights;
+
+    ws.setDist(source, 0.0, -1);
+    ws.push(0.0, source);
+
+    while (!ws.heapEmpty()) {
+        auto [currentDist, u] = ws.pop();
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = heads[e];
+            double candidate = currentDist + weights[e];
+            if (candidate < ws.getDist(v)) {
+                ws.setDist(v, candidate, u);
+                ws.push(candidate, v);
+            }
+        }
+    }
+
+    for (int v = 0; v < graph.nodeCount; ++v) {
+        out[v] = ws.getDist(v);
+    }
+}
+
+void buildLandmarks(int count) {
+    const CSRGraph& graph = getCSRGraph();
+    int n = graph.nodeCount;
+
+    landmarkTable.valid = false;
+    landmarkTable.landmarks.clear();
+    landmarkTable.nodeCount = n;
+    landmarkTable.landmarkCount = 0;
+
+    if (n == 0 || count <= 0) {
+        return;
+    }
+
+    count = std::min(count, n);
+    landmarkTable.fromLandmark.assign(static_cast<size_t>(count) * n, INF_DIST);
+    landmarkTable.toLandmark.assign(static_cast<size_t>(count) * n, INF_DIST);
+
+    // Farthest-point selection: each new landmark is the node worst covered
+    // by the ones chosen so far. Nodes no landmark can reach count as uncovered.
+    std::vector<double> coverage(n, INF_DIST);
+
+    // Seed with the node farthest from node 0
+    std::vector<double> seedDist(n);
+    distancesFrom(graph, 0, false, seedDist.data());
+    int next = 0;
+    for (int v = 0; v < n; ++v) {
+        if (seedDist[v] != INF_DIST && seedDist[v] > seedDist[next]) {
+            next = v;
+        }
+    }
+
+    for (int k = 0; k < count; ++k) {
+        double* from = &landmarkTable.fromLandmark[static_cast<size_t>(k) * n];
+        double* to = &landmarkTable.toLandmark[static_cast<size_t>(k) * n];
+
+        landmarkTable.landmarks.push_back(next);
+        distancesFrom(graph, next, false, from);
+        distancesFrom(graph, next, true, to);
+
+        for (int v = 0; v < n; ++v) {
+            coverage[v] = std::min(coverage[v], std::min(from[v], to[v]));
+        }
+
+        // Next landmark: largest coverage (unreachable first), lowest index on ties
+        next = -1;
+        for (int v = 0; v < n; ++v) {
+            if (coverage[v] > 0.0 && (next == -1 || coverage[v] > coverage[next])) {
+                next = v;
+            }
+        }
+        landmarkTable.landmarkCount = k + 1;
+        if (next == -1) break;
+    }
+
+    landmarkTable.fromLandmark.resize(static_cast<size_t>(landmarkTable.landmarkCount) * n);
+    landmarkTable.toLandmark.resize(static_cast<size_t>(landmarkTable.landmarkCount) * n);
+    landmarkTable.builtForVersion = graphVersion;
+    landmarkTable.valid = true;
+
+    std::cerr << "[ALT] Built " << landmarkTable.landmarkCount << " landmarks for "
+              << n << " nodes\n";
+}
+
+bool ensureLandmarks() {
+    if (landmarkTable.landmarkCount == 0) {
+        return false;
+    }
+    if (!landmarkTable.valid || landmarkTable.builtForVersion != graphVersion) {
+        buildLandmarks(landmarkTable.landmarkCount);
+    }
+    return landmarkTable.valid;
+}
+
+// Decrease-only Dijkstra from the seeded entries of one table
+static void propagateDecreases(const CSRGraph& graph, bool reverse, double* table, SearchWorkspace& ws) {
+    const std::vector<int>& offsets = reverse ? graph.revOffsets : graph.offsets;
+    const std::vector<int>& heads = reverse ? graph.revSources : graph.targets;
+    const std::vector<double>& weights = reverse ? graph.revWeights : graph.weights;
+
+    while (!ws.heapEmpty()) {
+        auto [key, u] = ws.pop();
+        if (key > table[u]) continue;
+
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = heads[e];
+            double candidate = key + weights[e];
+            if (candidate < table[v]) {
+                table[v] = candidate;
+                ws.push(candidate, v);
+            }
+        }
+    }
+}
+
+void applyEdgeChangesToLandmarks(const std::vector<EdgeWeightChange>& changes, unsigned long previousVersion) {
+    if (!landmarkTable.valid || landmarkTable.builtForVersion != previousVersion) {
+        return;
+    }
+
+    const CSRGraph& graph = getCSRGraph();
+    int n = landmarkTable.nodeCount;
+    SearchWorkspace& ws = getSearchWorkspace();
+
+    for (int k = 0; k < landmarkTable.landmarkCount; ++k) {
+        double* from = &landmarkTable.fromLandmark[static_cast<size_t>(k) * n];
+        double* to = &landmarkTable.toLandmark[static_cast<size_t>(k) * n];
+
+        // d(L, v) through a cheaper u -> v
+        ws.reset(n);
+        for (const EdgeWeightChange& c : changes) {
+            int v = graph.targets[c.edge];
+            double candidate = from[c.from] + c.newWeight;
+            if (c.newWeight < c.oldWeight && candidate < from[v]) {
+                from[v] = candidate;
+                ws.push(candidate, v);
+            }
+        }
+        propagateDecreases(graph, false, from, ws);
+
+        // d(u, L) through a cheaper u -> v
+        ws.reset(n);
+        for (const EdgeWeightChange& c : changes) {
+            int v = graph.targets[c.edge];
+            double candidate = to[v] + c.newWeight;
+            if (c.newWeight < c.oldWeight && candidate < to[c.from]) {
+                to[c.from] = candidate;
+                ws.push(candidate, c.from);
+            }
+        }
+        propagateDecreases(graph, true, to, ws);
+    }
+
+    landmarkTable.builtForVersion = graphVersion;
+}
+
+double landmarkLowerBound(int node, int target) {
+    if (!ensureLandmarks()) {
+        return 0.0;
+    }
+
+    int n = landmarkTable.nodeCount;
+    double best = 0.0;
+
+    for (int k = 0; k < landmarkTable.landmarkCount; ++k) {
+        const double* from = &landmarkTable.fromLandmark[static_cast<size_t>(k) * n];
+        const double* to = &landmarkTable.toLandmark[static_cast<size_t>(k) * n];
+
+        // d(L, t) <= d(L, v) + d(v, t)
+        if (from[node] != INF_DIST) {
+            if (from[target] == INF_DIST) return INF_DIST;
+            best = std::max(best, from[target] - from[node]);
+        }
+
+        // d(v, L) <= d(v, t) + d(t, L)
+        if (to[target] != INF_DIST) {
+            if (to[node] == INF_DIST) return INF_DIST;
+            best = std::max(best, to[node] - to[target]);
+        }
+    }
+
+    return best;
+}
+
+bool saveLandmarks(const std::string& filename) {
+    if (!ensureLandmarks()) {
+        std::cerr << "[ALT] No landmark table to save\n";
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "[ALT] Could not open " << filename << " for writing\n";
+        return false;
+    }
+
+    unsigned long long fingerprint = computeGraphFingerprint(getCSRGraph());
+    size_t tableSize = landmarkTable.fromLandmark.size();
+
+    file.write(LANDMARK_FILE_MAGIC, sizeof(LANDMARK_FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&fingerprint), sizeof(fingerprint));
+    file.write(reinterpret_cast<const char*>(&landmarkTable.nodeCount), sizeof(int));
+    file.write(reinterpret_cast<const char*>(&landmarkTable.landmarkCount), sizeof(int));
+    file.write(reinterpret_cast<const char*>(landmarkTable.landmarks.data()),
+               landmarkTable.landmarks.size() * sizeof(int));
+    file.write(reinterpret_cast<const char*>(landmarkTable.fromLandmark.data()),
+               tableSize * sizeof(double));
+    file.write(reinterpret_cast<const char*>(landmarkTable.toLandmark.data()),
+               tableSize * sizeof(double));
+
+    std::cerr << "[ALT] Saved " << landmarkTable.landmarkCount << " landmarks to " << filename << "\n";
+    return static_cast<bool>(file);
+}
+
+bool loadLandmarks(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    unsigned long long fingerprint = 0;
+    int nodeCount = 0;
+    int landmarkCount = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&fingerprint), sizeof(fingerprint));
+    file.read(reinterpret_cast<char*>(&nodeCount), sizeof(int));
+    file.read(reinterpret_cast<char*>(&landmarkCount), sizeof(int));
+
+    const CSRGraph& graph = getCSRGraph();
+    if (!file || !std::equal(magic, magic + 4, LANDMARK_FILE_MAGIC) ||
+        fingerprint != computeGraphFingerprint(graph) || nodeCount != graph.nodeCount ||
+        landmarkCount <= 0) {
+        std::cerr << "[ALT] " << filename << " does not match the current graph - ignoring\n";
+        return false;
+    }
+
+    size_t tableSize = static_cast<size_t>(landmarkCount) * nodeCount;
+    LandmarkTable loaded;
+    loaded.nodeCount = nodeCount;
+    loaded.landmarkCount = landmarkCount;
+    loaded.landmarks.resize(landmarkCount);
+    loaded.fromLandmark.resize(tableSize);
+    loaded.toLandmark.resize(tableSize);
+
+    file.read(reinterpret_cast<char*>(loaded.landmarks.data()), landmarkCount * sizeof(int));
+    file.read(reinterpret_cast<char*>(loaded.fromLandmark.data()), tableSize * sizeof(double));
+    file.read(reinterpret_cast<char*>(loaded.toLandmark.data()), tableSize * sizeof(double));
+
+    if (!file) {
+        std::cerr << "[ALT] " << filename << " is truncated - ignoring\n";
+        return false;
+    }
+
+    loaded.builtForVersion = graphVersion;
+    loaded.valid = true;
+    landmarkTable = std::move(loaded);
+
+    std::cerr << "[ALT] Loaded " << landmarkCount << " landmarks from " << filename << "\n";
+    return true;
+}
@@ -1,17 +1,101 @@
 #include <iostream>
 #include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
 #include "../includes/datatypes.hpp"
 #include "../includes/robot.hpp"
 #include "../includes/initSim.hpp"
 #include "../includes/eventSystem.hpp"
 #include "../includes/jsonComm.hpp"
 #include "../includes/logger.hpp"
+#include "../includes/distanceMatrix.hpp"
+#include "../includes/landmarks.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/spaceTimePlanner.hpp"
+#include "../includes/cbsPlanner.hpp"
+#include "../includes/congestion.hpp"
+#include "../includes/pathCache.hpp"
 
 // Configuration
 const double EPISODE_DURATION = 3600.0;  // 1 hour
 const double TIMESTEP = 1.0;             // 1 second
 const bool ENABLE_LOGGING = true;
 const bool ENABLE_JSON_LOGGING = false;  // Set to true for debug
+const bool ENABLE_NEXT_EVENT_ADVANCE = true;  // Jump over ticks where nothing happens
+const bool ENABLE_CONGESTION_ROUTING = false;  // Route around traffic instead of using cached static routes
+
+// A tick is quiet when no event or timer fires in it and no robot arrives.
+// Returns how many ticks from simTime on the event queue, the timer wheel
+// and the robots' arrival times allow to be taken as quiet ones.
+int quietTickLimit(double simTime) {
+    // Space-time planning books and releases per-second slots; keep stepping
+    if (isSpaceTimePlanningEnabled()) return 0;
+
+    // The tick starting at currentSimTime handles everything due up to currentSimTime + TIMESTEP
+    double now = EventSystemAccess::getCurrentSimTime();
+    auto ticksBefore = [now](double time) {
+        return static_cast<int>(std::ceil((time - now) / TIMESTEP)) - 1;
+    };
+
+    int limit = static_cast<int>((EPISODE_DURATION - simTime) / TIMESTEP);
+    if (!eventQueue.empty()) {
+        limit = std::min(limit, ticksBefore(eventQueue.top().getTriggerTime()));
+    }
+    double nextTimer = EventSystemAccess::getNextTimerTime();
+    if (nextTimer >= 0.0) {
+        limit = std::min(limit, ticksBefore(nextTimer));
+    }
+
+    for (const Robot& robot : robots) {
+        if (robot.getStatus() == RobotStatus::Moving) {
+            // Arrival takes ceil(remaining / step) ticks and the arriving tick is a regular one
+            double step = TIMESTEP * robot.getSpeed();
+            if (step <= 0.0) continue;
+            limit = std::min(limit, static_cast<int>(std::ceil((1.0 - robot.getProgress()) / step)) - 1);
+        }
+    }
+    return std::max(0, limit);
+}
+
+// Take up to 'ticks' quiet ticks from simTime in one go. Moving robots still
+// advance and every tick gets its snapshot, so the logs match fixed
+// stepping. Returns the number of ticks taken.
+int advanceQuietTicks(double simTime, int ticks) {
+    int taken = 0;
+    for (; taken < ticks; ++taken) {
+        // The estimate above can be one tick off the summed progress; an arrival ends the run
+        bool arriving = false;
+        for (const Robot& robot : robots) {
+            if (robot.getStatus() == RobotStatus::Moving &&
+                robot.getProgress() + TIMESTEP * robot.getSpeed() >= 1.0) {
+                arriving = true;
+                break;
+            }
+        }
+        if (arriving) break;
+
+        for (Robot& robot : robots) {
+            if (robot.getStatus() != RobotStatus::Moving) continue;
+            robot.setProgress(robot.getProgress() + TIMESTEP * robot.getSpeed());
+            robot.useBattery(0.1 * TIMESTEP);
+            updateRobotPosition(robot);
+        }
+
+        if (ENABLE_LOGGING) {
+            logSnapshot(simTime + taken * TIMESTEP);
+        }
+    }
+
+    if (taken > 0) {
+        // Nothing is due before the new time, so this only moves the clock
+        processEvents(taken * TIMESTEP);
+        if (isCongestionAwareRoutingEnabled()) {
+            updateCongestion(taken);
+        }
+    }
+    return taken;
+}
 
 
 int main(int argc, char* argv[]) {
@@ -46,7 +130,18 @@ int main(int argc, char* argv[]) {
     
     std::cerr << "[INIT] Initializing graph layout...\n";
     initGraphLayout();
+
+    // Edge lengths are a few metres, far above the radix heap's fixed-point step
+    setQueueBackend(QueueBackend::RadixHeap);
     
+    std::cerr << "[INIT] Building distance table...\n";
+    buildDistanceMatrix();
+
+    std::cerr << "[INIT] Building landmark heuristic...\n";
+    buildLandmarks(4);
+    setHeuristicMode(HeuristicMode::Landmarks);
+    setCongestionAwareRouting(ENABLE_CONGESTION_ROUTING);
+
     std::cerr << "[INIT] Initializing robots...\n";
     initRobots();
     
@@ -90,9 +185,28 @@ int main(int argc, char* argv[]) {
         }
         
         double simTime = 0.0;
+        int steppedTicks = 0;
+        int skippedTicks = 0;
+        auto episodeStart = std::chrono::steady_clock::now();
         
         // Episode loop
         while (simTime < EPISODE_DURATION) {
+            // Jump to the next event or robot arrival
+            if (ENABLE_NEXT_EVENT_ADVANCE) {
+                int quiet = advanceQuietTicks(simTime, quietTickLimit(simTime));
+                if (quiet > 0) {
+                    double previousTime = simTime;
+                    simTime += quiet * TIMESTEP;
+                    skippedTicks += quiet;
+                    
+                    if (static_cast<int>(simTime) / 10 != static_cast<int>(previousTime) / 10) {
+                        std::cerr << "[TIME] " << simTime << "s / " << EPISODE_DURATION << "s\n";
+                    }
+                    continue;
+                }
+            }
+            steppedTicks++;
+            
             // Process events (this will send tasks to RL and wait for decisions)
             processEvents(TIMESTEP);
             
@@ -116,24 +230,26 @@ int main(int argc, char* argv[]) {
                         
                         std::cerr << "[ROBOT] " << robot.getId() 
                                   << " arrived at node " << robot.getCurrentNode() << "\n";
+                        
+                        // Reports LOW_BATTERY now and then periodically while idle
+                        startBatteryWatch(i);
                     }
-                }
-                
-                // Check battery
-                if (robot.needsCharging(20.0) && robot.isIdle()) {
-                    std::cerr << "[ROBOT] " << robot.getId() 
-                              << " needs charging (battery: " << robot.getBattery() << "%)\n";
                     
-                    // Send status to RL
-                    if (globalJsonComm) {
-                        globalJsonComm->sendRobotStatus(
-                            i, 
-                            StatusType::LOW_BATTERY, 
-                            "", 
-                            simTime,
-                            "Battery low, requesting charge"
-                        );
-                    }
+                    updateRobotPosition(robot);
+                }
+            }
+            
+            // Drop reservations that already lie in the past
+            if (isSpaceTimePlanningEnabled() && static_cast<int>(simTime) % 60 == 0) {
+                reservationTable.releaseBefore(simTime);
+            }
+            
+            // Replan the whole fleet together so the bookings stay conflict-free
+            if (isSpaceTimePlanningEnabled() && isMultiRobotPlanningEnabled() &&
+                static_cast<int>(simTime) % CBS_REPLAN_INTERVAL == 0) {
+                MultiRobotPlan plan = planPendingRobots(simTime);
+                if (plan.getRobotCount() > 0) {
+                    applyMultiRobotPlan(plan, reservationTable, simTime);
                 }
             }
             
@@ -142,6 +258,11 @@ int main(int argc, char* argv[]) {
                 logSnapshot(simTime);
             }
             
+            // Refresh congested edge costs from occupancy and the heatmap
+            if (isCongestionAwareRoutingEnabled()) {
+                updateCongestion();
+            }
+            
             // Increment time
             simTime += TIMESTEP;
             
@@ -152,6 +273,10 @@ int main(int argc, char* argv[]) {
         }
         
         std::cerr << "\n=== Episode " << episodeNumber << " Ended ===\n";
+        std::cerr << "[TIME] " << steppedTicks << " ticks stepped, " << skippedTicks << " skipped, "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - episodeStart).count()
+                  << "s wall time\n";
+        pathCache.printStats();
         
         // End episode logging
         if (ENABLE_LOGGING) {
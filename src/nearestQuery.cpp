@@ -0,0 +1,169 @@
+#include "../includes/nearestQuery.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include "../includes/robot.hpp"
+#include <algorithm>
+
+static const double INF_DIST = std::numeric_limits<double>::infinity();
+
+// One field per NodeType
+static FacilityField facilityFields[5];
+
+namespace {
+
+// Dijkstra from 'node' (forward: d(node, v), reverse: d(v, node)) that stops
+// as soon as every node at the distance of the first match has been popped.
+// candidateAt(v) returns an id (>= 0) for a match at v, or -1. The lowest
+// id wins among equally distant matches.
+int searchNearest(int node, bool reverse, double maxDistance, const std::function<int(int)>& candidateAt,
+                  double* outDistance) {
+    const CSRGraph& graph = getCSRGraph();
+    if (outDistance) *outDistance = INF_DIST;
+    if (node < 0 || node >= graph.nodeCount) return -1;
+
+    const std::vector<int>& offsets = reverse ? graph.revOffsets : graph.offsets;
+    const std::vector<int>& heads = reverse ? graph.revSources : graph.targets;
+    const std::vector<double>& weights = reverse ? graph.revWeights : graph.weights;
+
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+    ws.setDist(node, 0.0, -1);
+    ws.push(0.0, node);
+
+    int best = -1;
+    double bestDist = INF_DIST;
+
+    while (!ws.heapEmpty()) {
+        auto [d, u] = ws.pop();
+        if (d > bestDist || d >= maxDistance) break;
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        int candidate = candidateAt(u);
+        if (candidate >= 0) {
+            if (best == -1 || candidate < best) best = candidate;
+            bestDist = d;
+            continue;   // Nothing beyond a match can be closer
+        }
+
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = heads[e];
+            double next = d + weights[e];
+            if (next < ws.getDist(v)) {
+                ws.setDist(v, next, u);
+                ws.push(next, v);
+            }
+        }
+    }
+
+    if (best != -1 && outDistance) *outDistance = bestDist;
+    return best;
+}
+
+} // namespace
+
+void multiSourceDistances(const std::vector<int>& sources, std::vector<double>& outDist,
+                          std::vector<int>& outNearest) {
+    const CSRGraph& graph = getCSRGraph();
+    int n = graph.nodeCount;
+    outDist.assign(n, INF_DIST);
+    outNearest.assign(n, -1);
+
+    // Reverse search, so the distances are towards the sources
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(n);
+    for (int s : sources) {
+        if (s < 0 || s >= n) continue;
+        if (outNearest[s] == -1 || s < outNearest[s]) {
+            outDist[s] = 0.0;
+            outNearest[s] = s;
+            ws.push(0.0, s);
+        }
+    }
+
+    while (!ws.heapEmpty()) {
+        auto [d, u] = ws.pop();
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+
+        for (int r = graph.getRevEdgeBegin(u); r < graph.getRevEdgeEnd(u); ++r) {
+            int v = graph.revSources[r];
+            double next = d + graph.revWeights[r];
+            if (next < outDist[v] || (next == outDist[v] && outNearest[u] < outNearest[v] && !ws.isClosed(v))) {
+                outDist[v] = next;
+                outNearest[v] = outNearest[u];
+                ws.push(next, v);
+            }
+        }
+    }
+}
+
+const FacilityField& getFacilityField(NodeType type) {
+    FacilityField& field = facilityFields[static_cast<int>(type)];
+    if (field.valid && field.builtForVersion == graphVersion) {
+        return field;
+    }
+
+    std::vector<int> sources;
+    for (int v = 0; v < static_cast<int>(nodes.size()); ++v) {
+        if (nodes[v].getType() == type) sources.push_back(v);
+    }
+
+    multiSourceDistances(sources, field.dist, field.nearest);
+    field.type = type;
+    field.builtForVersion = graphVersion;
+    field.valid = true;
+    return field;
+}
+
+int findNearestFacility(int node, NodeType type, double* outDistance) {
+    if (outDistance) *outDistance = INF_DIST;
+    if (node < 0 || node >= static_cast<int>(nodes.size())) return -1;
+
+    const FacilityField& field = getFacilityField(type);
+    if (outDistance) *outDistance = field.getDistance(node);
+    return field.getNearest(node);
+}
+
+int findNearestFreeCharger(int node, double maxDistance, double* outDistance) {
+    return searchNearest(node, false, maxDistance, [](int v) {
+        const ChargingStation* station = nodes[v].getChargingStation();
+        return (station && station->getIsOccupied() < station->getChargingPorts()) ? v : -1;
+    }, outDistance);
+}
+
+int findNearestRobot(int node, const std::function<bool(int)>& eligible, double maxDistance, double* outDistance) {
+    // Lowest eligible robot index per node, valid where the stamp is current
+    thread_local std::vector<int> robotAt;
+    thread_local std::vector<unsigned int> stamp;
+    thread_local unsigned int generation = 0;
+
+    int n = static_cast<int>(nodes.size());
+    if (static_cast<int>(robotAt.size()) < n) {
+        robotAt.resize(n);
+        stamp.resize(n, 0);
+    }
+    if (++generation == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+
+    bool any = false;
+    for (int i = 0; i < static_cast<int>(robots.size()); ++i) {
+        int at = robots[i].getCurrentNode();
+        if (at < 0 || at >= n || !eligible(i)) continue;
+        if (stamp[at] != generation) {
+            stamp[at] = generation;
+            robotAt[at] = i;
+        }
+        any = true;
+    }
+    if (!any) {
+        if (outDistance) *outDistance = INF_DIST;
+        return -1;
+    }
+
+    return searchNearest(node, true, maxDistance, [](int v) {
+        return stamp[v] == generation ? robotAt[v] : -1;
+    }, outDistance);
+}
@@ -0,0 +1,138 @@
+#include "../includes/pathCache.hpp"
+#include "../includes/pathConstraints.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/distanceMatrix.hpp"
+#include <iostream>
+
+PathCache pathCache;
+
+// Called with the mutex held
+void PathCache::checkEpoch() {
+    if (epoch == graphVersion) return;
+
+    if (!lru.empty()) {
+        invalidations += lru.size();
+        lru.clear();
+        index.clear();
+    }
+    epoch = graphVersion;
+}
+
+SharedPath PathCache::lookup(const PathCacheKey& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkEpoch();
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++misses;
+        return nullptr;
+    }
+
+    ++hits;
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->path;
+}
+
+void PathCache::insert(const PathCacheKey& key, SharedPath path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkEpoch();
+    if (capacity == 0 || key.epoch != epoch) return;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->path = std::move(path);
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    while (lru.size() >= capacity) {
+        index.erase(lru.back().key);
+        lru.pop_back();
+        ++evictions;
+    }
+    lru.push_front({key, std::move(path)});
+    index[key] = lru.begin();
+}
+
+void PathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+    hits = misses = evictions = invalidations = 0;
+}
+
+void PathCache::setCapacity(size_t maxEntries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = maxEntries;
+    while (lru.size() > capacity) {
+        index.erase(lru.back().key);
+        lru.pop_back();
+        ++evictions;
+    }
+}
+
+void PathCache::revalidate(unsigned long previousEpoch,
+                           const std::function<bool(const PathCacheKey&, const Path&)>& keep) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (epoch != previousEpoch) {
+        checkEpoch();
+        return;
+    }
+
+    index.clear();
+    for (auto it = lru.begin(); it != lru.end(); ) {
+        if (!keep(it->key, *it->path)) {
+            it = lru.erase(it);
+            ++invalidations;
+            continue;
+        }
+        it->key.epoch = graphVersion;
+        index[it->key] = it;
+        ++it;
+    }
+    epoch = graphVersion;
+}
+
+size_t PathCache::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+void PathCache::printStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    unsigned long long total = hits + misses;
+    std::cerr << "[PATHCACHE] " << lru.size() << "/" << capacity << " entries, "
+              << hits << " hits, " << misses << " misses ("
+              << (total == 0 ? 0.0 : 100.0 * hits / total) << "% hit rate), "
+              << evictions << " evicted, " << invalidations << " invalidated\n";
+}
+
+SharedPath getSharedPath(int startNode, int goalNode) {
+    PathCacheKey key{startNode, goalNode, 0, graphVersion};
+    SharedPath path = pathCache.lookup(key);
+    if (path) return path;
+
+    // Next-hop table while it matches the layout, otherwise bidirectional Dijkstra
+    path = std::make_shared<const Path>(isDistanceMatrixCurrent()
+        ? getCachedPath(startNode, goalNode)
+        : findShortestPathBidirectional(startNode, goalNode));
+    pathCache.insert(key, path);
+    return path;
+}
+
+SharedPath getSharedConstrainedPath(int startNode, int goalNode, const PathConstraints& constraints) {
+    if (constraints.isEmpty()) {
+        return getSharedPath(startNode, goalNode);
+    }
+    if (constraints.getSkipFullNodes() || constraints.hasNodeFilter()) {
+        return std::make_shared<const Path>(findConstrainedPath(startNode, goalNode, constraints));
+    }
+
+    PathCacheKey key{startNode, goalNode, constraints.getHash(), graphVersion};
+    SharedPath path = pathCache.lookup(key);
+    if (path) return path;
+
+    path = std::make_shared<const Path>(findConstrainedPath(startNode, goalNode, constraints));
+    pathCache.insert(key, path);
+    return path;
+}
@@ -0,0 +1,105 @@
+#include "../includes/pathConstraints.hpp"
+#include "../includes/csrGraph.hpp"
+#include <algorithm>
+
+void PathConstraints::forbidNode(int node) {
+    if (node >= 0) forbiddenNodes.set(node);
+}
+
+void PathConstraints::forbidNodes(const std::vector<int>& nodeList) {
+    for (int node : nodeList) {
+        forbidNode(node);
+    }
+}
+
+void PathConstraints::allowNode(int node) {
+    if (node >= 0) forbiddenNodes.reset(node);
+}
+
+void PathConstraints::forbidEdge(int fromNode, int toNode) {
+    forbiddenPairs.emplace_back(fromNode, toNode);
+    edgesResolved = false;   // Resolve again on next use
+}
+
+void PathConstraints::setNodeFilter(std::function<bool(int)> filter, unsigned long id) {
+    nodeFilter = std::move(filter);
+    filterId = nodeFilter ? id : 0;
+}
+
+void PathConstraints::clear() {
+    forbiddenNodes.clear();
+    forbiddenEdges.clear();
+    forbiddenPairs.clear();
+    edgesResolved = false;
+    skipFullNodes = false;
+    nodeFilter = nullptr;
+    filterId = 0;
+}
+
+// Edge ids change when the CSR graph is rebuilt, so map the (from, to)
+// pairs to ids lazily for the current version
+void PathConstraints::resolveEdges() const {
+    const CSRGraph& graph = getCSRGraph();
+    if (edgesResolved && edgesForVersion == graph.builtForVersion) return;
+
+    forbiddenEdges.clear();
+    for (const auto& [from, to] : forbiddenPairs) {
+        if (from < 0 || from >= graph.nodeCount) continue;
+        for (int e = graph.getEdgeBegin(from); e < graph.getEdgeEnd(from); ++e) {
+            if (graph.targets[e] == to) forbiddenEdges.set(e);
+        }
+    }
+    edgesForVersion = graph.builtForVersion;
+    edgesResolved = true;
+}
+
+bool PathConstraints::isNodeAllowed(int node, bool isStart) const {
+    if (forbiddenNodes.test(node)) return false;
+    if (skipFullNodes && !isStart && nodes[node].currentRobots >= nodes[node].maxRobots) return false;
+    if (nodeFilter && !nodeFilter(node)) return false;
+    return true;
+}
+
+bool PathConstraints::isEdgeAllowed(int edgeId) const {
+    if (forbiddenPairs.empty()) return true;
+    resolveEdges();
+    return !forbiddenEdges.test(edgeId);
+}
+
+bool PathConstraints::isEmpty() const {
+    return !forbiddenNodes.any() && forbiddenPairs.empty() && !skipFullNodes && !nodeFilter;
+}
+
+unsigned long long PathConstraints::getHash() const {
+    if (isEmpty()) return 0;
+
+    // FNV-1a over the set words (with their index, so trailing zero words don't matter)
+    unsigned long long hash = 1469598103934665603ULL;
+    auto mix = [&hash](unsigned long long value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    for (size_t w = 0; w < forbiddenNodes.words.size(); ++w) {
+        if (forbiddenNodes.words[w]) {
+            mix(w);
+            mix(forbiddenNodes.words[w]);
+        }
+    }
+    mix(0xffffffffffffffffULL);   // Separator between nodes and edges
+
+    // Pairs rather than resolved ids, so the hash survives a CSR rebuild
+    std::vector<std::pair<int, int>> pairs = forbiddenPairs;
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    for (const auto& [from, to] : pairs) {
+        mix(static_cast<unsigned long long>(static_cast<unsigned int>(from)) << 32 |
+            static_cast<unsigned int>(to));
+    }
+
+    mix(skipFullNodes ? 1 : 0);
+    mix(filterId);
+    return hash == 0 ? 1 : hash;
+}
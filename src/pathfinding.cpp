@@ -1,6 +1,9 @@
 #include "../includes/pathfinding.hpp"
 #include "../includes/datatypes.hpp"
-#include <queue>
+#include "../includes/csrGraph.hpp"
+#include "../includes/searchWorkspace.hpp"
+#include "../includes/landmarks.hpp"
+#include "../includes/pathConstraints.hpp"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
@@ -23,79 +26,154 @@ void Path::print() const {
     std::cerr << "\n";
 }
 
-// Dijkstra's algorithm - returns distances from source to all nodes
-std::vector<double> dijkstraDistances(int sourceNode) {
-    int n = static_cast<int>(nodes.size());
-    std::vector<double> dist(n, INF);
-    std::vector<bool> visited(n, false);
-    
-    // Priority queue: (distance, node)
-    std::priority_queue<std::pair<double, int>, 
-                       std::vector<std::pair<double, int>>,
-                       std::greater<std::pair<double, int>>> pq;
-    
-    dist[sourceNode] = 0.0;
-    pq.push({0.0, sourceNode});
+static QueueBackend queueBackend = QueueBackend::BinaryHeap;
+
+// Finest fixed-point step we allow the radix heap (2^-20)
+static const double MAX_RADIX_SCALE = 1048576.0;
+
+void setQueueBackend(QueueBackend backend) {
+    queueBackend = backend;
+}
+
+QueueBackend getQueueBackend() {
+    return queueBackend;
+}
+
+// Adapts the workspace's own lazy binary heap to the update()/pop() interface
+struct WorkspaceBinaryHeap {
+    SearchWorkspace& ws;
+    bool empty() const { return ws.heapEmpty(); }
+    void update(double key, int v) { ws.push(key, v); }
+    std::pair<double, int> pop() { return ws.pop(); }
+};
+
+template <typename Queue>
+static void runDijkstraWith(SearchWorkspace& ws, Queue& queue, const CSRGraph& graph, int sourceNode, int targetNode) {
+    ws.setDist(sourceNode, 0.0, -1);
+    queue.update(0.0, sourceNode);
     
-    while (!pq.empty()) {
-        auto [currentDist, u] = pq.top();
-        pq.pop();
+    while (!queue.empty()) {
+        int u = queue.pop().second;
+        
+        // Early termination if we reached the target
+        if (u == targetNode) break;
         
-        if (visited[u]) continue;
-        visited[u] = true;
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+        
+        // Exact distance (queue keys may be rounded)
+        double currentDist = ws.getDist(u);
         
         // Check all adjacent nodes
-        for (const Edge& edge : adj[u]) {
-            int v = edge.to;
-            double weight = edge.distance;
+        for (int e = graph.getEdgeBegin(u); e < graph.getEdgeEnd(u); ++e) {
+            int v = graph.targets[e];
+            double candidate = currentDist + graph.weights[e];
             
             // Relaxation
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                pq.push({dist[v], v});
+            if (candidate < ws.getDist(v)) {
+                ws.setDist(v, candidate, u);
+                queue.update(candidate, v);
             }
         }
     }
+}
+
+// Run Dijkstra from sourceNode into the thread's workspace.
+// Stops early once targetNode (if >= 0) has been popped.
+static void runDijkstra(SearchWorkspace& ws, const CSRGraph& graph, int sourceNode, int targetNode) {
+    ws.reset(graph.nodeCount);
+    
+    if (queueBackend == QueueBackend::DaryHeap) {
+        ws.daryHeap.reset(graph.nodeCount);
+        runDijkstraWith(ws, ws.daryHeap, graph, sourceNode, targetNode);
+        return;
+    }
     
-    return dist;
+    // Any fixed-point step no larger than the lightest edge keeps the order exact
+    if (queueBackend == QueueBackend::RadixHeap && graph.minWeight > 0.0) {
+        double scale = std::exp2(std::ceil(std::log2(1.0 / graph.minWeight)));
+        if (scale <= MAX_RADIX_SCALE) {
+            ws.radixHeap.reset(std::max(1.0, scale));
+            runDijkstraWith(ws, ws.radixHeap, graph, sourceNode, targetNode);
+            return;
+        }
+    }
+    
+    WorkspaceBinaryHeap heap{ws};
+    runDijkstraWith(ws, heap, graph, sourceNode, targetNode);
 }
 
-// Dijkstra with predecessor tracking for path reconstruction
-std::vector<int> dijkstraPredecessors(int sourceNode) {
-    int n = static_cast<int>(nodes.size());
-    std::vector<double> dist(n, INF);
-    std::vector<int> pred(n, -1);
-    std::vector<bool> visited(n, false);
+// Build a path from the predecessors stored in a workspace.
+// Counts the hops first so the node list is allocated exactly once.
+static Path reconstructFromWorkspace(const SearchWorkspace& ws, int startNode, int endNode) {
+    Path path;
+    path.found = false;
+    path.totalDistance = INF;
     
-    std::priority_queue<std::pair<double, int>, 
-                       std::vector<std::pair<double, int>>,
-                       std::greater<std::pair<double, int>>> pq;
+    if (!ws.isSeen(endNode)) {
+        return path;
+    }
+    
+    int hops = 1;
+    int current = endNode;
+    while (current != startNode && current != -1) {
+        current = ws.getPred(current);
+        ++hops;
+    }
     
-    dist[sourceNode] = 0.0;
-    pq.push({0.0, sourceNode});
+    // Check if we reached the start
+    if (current != startNode) {
+        return path;
+    }
     
-    while (!pq.empty()) {
-        auto [currentDist, u] = pq.top();
-        pq.pop();
-        
-        if (visited[u]) continue;
-        visited[u] = true;
-        
-        for (const Edge& edge : adj[u]) {
-            int v = edge.to;
-            double weight = edge.distance;
-            
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                pred[v] = u;
-                pq.push({dist[v], v});
-            }
-        }
+    path.nodes.resize(hops);
+    current = endNode;
+    for (int i = hops - 1; i >= 0; --i) {
+        path.nodes[i] = current;
+        current = ws.getPred(current);
     }
+    path.totalDistance = ws.getDist(endNode);
+    path.found = true;
     
+    return path;
+}
+
+// Dijkstra's algorithm - returns distances from source to all nodes
+std::vector<double> dijkstraDistances(int sourceNode) {
+    std::vector<double> dist;
+    dijkstraDistances(sourceNode, dist);
+    return dist;
+}
+
+void dijkstraDistances(int sourceNode, std::vector<double>& outDistances) {
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& ws = getSearchWorkspace();
+    runDijkstra(ws, graph, sourceNode, -1);
+    
+    outDistances.resize(graph.nodeCount);
+    for (int v = 0; v < graph.nodeCount; ++v) {
+        outDistances[v] = ws.getDist(v);
+    }
+}
+
+// Dijkstra with predecessor tracking for path reconstruction
+std::vector<int> dijkstraPredecessors(int sourceNode) {
+    std::vector<int> pred;
+    dijkstraPredecessors(sourceNode, pred);
     return pred;
 }
 
+void dijkstraPredecessors(int sourceNode, std::vector<int>& outPredecessors) {
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& ws = getSearchWorkspace();
+    runDijkstra(ws, graph, sourceNode, -1);
+    
+    outPredecessors.resize(graph.nodeCount);
+    for (int v = 0; v < graph.nodeCount; ++v) {
+        outPredecessors[v] = ws.getPred(v);
+    }
+}
+
 // Reconstruct path from predecessors
 Path reconstructPath(int startNode, int endNode, const std::vector<int>& predecessors,
                     const std::vector<double>& distances) {
@@ -152,112 +230,135 @@ Path findShortestPath(int startNode, int endNode) {
     }
     
     // Run Dijkstra
-    int n = static_cast<int>(nodes.size());
-    std::vector<double> dist(n, INF);
-    std::vector<int> pred(n, -1);
-    std::vector<bool> visited(n, false);
-    
-    std::priority_queue<std::pair<double, int>, 
-                       std::vector<std::pair<double, int>>,
-                       std::greater<std::pair<double, int>>> pq;
-    
-    dist[startNode] = 0.0;
-    pq.push({0.0, startNode});
-    
-    while (!pq.empty()) {
-        auto [currentDist, u] = pq.top();
-        pq.pop();
-        
-        // Early termination if we reached the target
-        if (u == endNode) break;
-        
-        if (visited[u]) continue;
-        visited[u] = true;
-        
-        for (const Edge& edge : adj[u]) {
-            int v = edge.to;
-            double weight = edge.distance;
-            
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                pred[v] = u;
-                pq.push({dist[v], v});
-            }
-        }
-    }
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& ws = getSearchWorkspace();
+    runDijkstra(ws, graph, startNode, endNode);
     
     // Reconstruct path
-    return reconstructPath(startNode, endNode, pred, dist);
+    return reconstructFromWorkspace(ws, startNode, endNode);
 }
 
-// Find path avoiding certain nodes
-Path findShortestPathAvoiding(int startNode, int endNode, const std::vector<int>& avoidNodes) {
-    // Check if start or end is in avoid list
-    if (std::find(avoidNodes.begin(), avoidNodes.end(), startNode) != avoidNodes.end() ||
-        std::find(avoidNodes.begin(), avoidNodes.end(), endNode) != avoidNodes.end()) {
+// Bidirectional Dijkstra: forward search from start over outgoing edges,
+// backward search from end over the reverse CSR arrays. Every scanned edge
+// that reaches a node seen by the other side is a candidate meeting point.
+// Once topForward + topBackward >= best no unsettled node can give a
+// shorter path, so the search stops there.
+Path findShortestPathBidirectional(int startNode, int endNode) {
+    // Validate nodes
+    if (startNode < 0 || startNode >= static_cast<int>(nodes.size()) ||
+        endNode < 0 || endNode >= static_cast<int>(nodes.size())) {
         Path invalidPath;
         invalidPath.found = false;
+        invalidPath.totalDistance = INF;
         return invalidPath;
     }
     
-    int n = static_cast<int>(nodes.size());
-    std::vector<double> dist(n, INF);
-    std::vector<int> pred(n, -1);
-    std::vector<bool> visited(n, false);
-    
-    // Mark avoided nodes as visited
-    for (int node : avoidNodes) {
-        if (node >= 0 && node < n) {
-            visited[node] = true;
-        }
+    // If start == end, return trivial path
+    if (startNode == endNode) {
+        Path trivialPath;
+        trivialPath.nodes.push_back(startNode);
+        trivialPath.totalDistance = 0.0;
+        trivialPath.found = true;
+        return trivialPath;
     }
     
-    std::priority_queue<std::pair<double, int>, 
-                       std::vector<std::pair<double, int>>,
-                       std::greater<std::pair<double, int>>> pq;
-    
-    dist[startNode] = 0.0;
-    visited[startNode] = false;  // Unmark start
-    pq.push({0.0, startNode});
-    
-    while (!pq.empty()) {
-        auto [currentDist, u] = pq.top();
-        pq.pop();
+    // Backward pred points one step closer to endNode
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& fwd = getSearchWorkspace();
+    SearchWorkspace& bwd = getReverseSearchWorkspace();
+    fwd.reset(graph.nodeCount);
+    bwd.reset(graph.nodeCount);
+    fwd.setDist(startNode, 0.0, -1);
+    fwd.push(0.0, startNode);
+    bwd.setDist(endNode, 0.0, -1);
+    bwd.push(0.0, endNode);
+    
+    double best = INF;
+    int meeting = -1;
+    
+    while (!fwd.heapEmpty() && !bwd.heapEmpty()) {
+        if (fwd.top().first + bwd.top().first >= best) break;
         
-        if (u == endNode) break;
+        // Grow the side with the smaller radius so both balls stay about d/2
+        bool forward = fwd.top().first <= bwd.top().first;
+        SearchWorkspace& ws = forward ? fwd : bwd;
+        const SearchWorkspace& other = forward ? bwd : fwd;
+        const std::vector<int>& offsets = forward ? graph.offsets : graph.revOffsets;
+        const std::vector<int>& heads = forward ? graph.targets : graph.revSources;
+        const std::vector<double>& weights = forward ? graph.weights : graph.revWeights;
         
-        if (visited[u]) continue;
-        visited[u] = true;
+        auto [currentDist, u] = ws.pop();
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
         
-        for (const Edge& edge : adj[u]) {
-            int v = edge.to;
-            double weight = edge.distance;
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = heads[e];
+            double candidate = currentDist + weights[e];
             
-            // Skip if node should be avoided
-            if (std::find(avoidNodes.begin(), avoidNodes.end(), v) != avoidNodes.end() &&
-                v != endNode) {
-                continue;
+            if (candidate < ws.getDist(v)) {
+                ws.setDist(v, candidate, u);
+                ws.push(candidate, v);
             }
             
-            if (dist[u] + weight < dist[v]) {
-                dist[v] = dist[u] + weight;
-                pred[v] = u;
-                pq.push({dist[v], v});
+            if (other.isSeen(v) && candidate + other.getDist(v) < best) {
+                best = candidate + other.getDist(v);
+                meeting = v;
             }
         }
     }
     
-    return reconstructPath(startNode, endNode, pred, dist);
+    Path path;
+    path.found = false;
+    path.totalDistance = INF;
+    if (meeting == -1) {
+        return path;
+    }
+    
+    // start -> meeting from the forward tree, meeting -> end from the backward tree
+    int forwardHops = 0;
+    for (int current = meeting; current != startNode; current = fwd.getPred(current)) {
+        ++forwardHops;
+    }
+    int backwardHops = 0;
+    for (int current = meeting; current != endNode; current = bwd.getPred(current)) {
+        ++backwardHops;
+    }
+    
+    path.nodes.resize(forwardHops + backwardHops + 1);
+    int current = meeting;
+    for (int i = forwardHops; i >= 0; --i) {
+        path.nodes[i] = current;
+        current = fwd.getPred(current);
+    }
+    current = meeting;
+    for (int i = forwardHops + 1; i <= forwardHops + backwardHops; ++i) {
+        current = bwd.getPred(current);
+        path.nodes[i] = current;
+    }
+    path.totalDistance = fwd.getDist(meeting) + bwd.getDist(meeting);
+    path.found = true;
+    
+    return path;
+}
+
+// Find path avoiding certain nodes
+Path findShortestPathAvoiding(int startNode, int endNode, const std::vector<int>& avoidNodes) {
+    // Bitset lookups instead of scanning avoidNodes for every relaxed edge
+    thread_local PathConstraints constraints;
+    constraints.clear();
+    constraints.forbidNodes(avoidNodes);
+    return findConstrainedPath(startNode, endNode, constraints);
 }
 
 // Check if edge exists
 bool hasEdge(int fromNode, int toNode) {
-    if (fromNode < 0 || fromNode >= static_cast<int>(adj.size())) {
+    const CSRGraph& graph = getCSRGraph();
+    if (fromNode < 0 || fromNode >= graph.nodeCount) {
         return false;
     }
     
-    for (const Edge& edge : adj[fromNode]) {
-        if (edge.to == toNode) {
+    for (int e = graph.getEdgeBegin(fromNode); e < graph.getEdgeEnd(fromNode); ++e) {
+        if (graph.targets[e] == toNode) {
             return true;
         }
     }
@@ -267,32 +368,49 @@ bool hasEdge(int fromNode, int toNode) {
 
 // Get edge distance
 double getEdgeDistance(int fromNode, int toNode) {
-    if (fromNode < 0 || fromNode >= static_cast<int>(adj.size())) {
-        return INF;
-    }
-    
-    for (const Edge& edge : adj[fromNode]) {
-        if (edge.to == toNode) {
-            return edge.distance;
-        }
-    }
-    
-    return INF;
+    // Cheapest parallel edge, like the searches use
+    return lightestEdgeWeight(getCSRGraph(), fromNode, toNode);
 }
 
-// Simple heuristic for A* (Euclidean distance - requires node positions)
-// For now, return 0 (makes it equivalent to Dijkstra)
+static HeuristicMode heuristicMode = HeuristicMode::Euclidean;
+
+void setHeuristicMode(HeuristicMode mode) {
+    heuristicMode = mode;
+}
+
+HeuristicMode getHeuristicMode() {
+    return heuristicMode;
+}
+
+// Euclidean distance between node positions, scaled so it never exceeds
+// the real path cost (admissible and consistent). Zero when the layout
+// has no coordinates, which makes A* fall back to Dijkstra behaviour.
+// Manhattan distance is not used since diagonal edges would make it overestimate.
+static double euclideanHeuristic(int node1, int node2) {
+    const CSRGraph& graph = getCSRGraph();
+    double dx = nodes[node2].getX() - nodes[node1].getX();
+    double dy = nodes[node2].getY() - nodes[node1].getY();
+    return graph.coordinateScale * std::sqrt(dx * dx + dy * dy);
+}
+
+// The max of two consistent lower bounds is still consistent, so in
+// Landmarks mode the coordinates are kept as an extra bound.
 double heuristicDistance(int node1, int node2) {
-    // If you have node positions (x, y), implement:
-    // double dx = nodes[node2].x - nodes[node1].x;
-    // double dy = nodes[node2].y - nodes[node1].y;
-    // return sqrt(dx*dx + dy*dy);
-    
-    // For now, return 0 (Dijkstra behavior)
-    return 0.0;
+    switch (heuristicMode) {
+        case HeuristicMode::None:
+            return 0.0;
+        case HeuristicMode::Landmarks:
+            if (landmarkTable.valid && landmarkTable.builtForVersion == graphVersion) {
+                return std::max(euclideanHeuristic(node1, node2), landmarkLowerBound(node1, node2));
+            }
+            return euclideanHeuristic(node1, node2);
+        case HeuristicMode::Euclidean:
+        default:
+            return euclideanHeuristic(node1, node2);
+    }
 }
 
-// A* pathfinding (future optimization)
+// A* pathfinding
 Path findPathAStar(int startNode, int endNode) {
     // Validate nodes
     if (startNode < 0 || startNode >= static_cast<int>(nodes.size()) ||
@@ -310,43 +428,116 @@ Path findPathAStar(int startNode, int endNode) {
         return trivialPath;
     }
     
-    int n = static_cast<int>(nodes.size());
-    std::vector<double> gScore(n, INF);  // Actual cost from start
-    std::vector<double> fScore(n, INF);  // Estimated total cost
-    std::vector<int> pred(n, -1);
-    std::vector<bool> visited(n, false);
+    // Landmark rebuild uses the same workspace, so it must happen before the search starts
+    if (heuristicMode == HeuristicMode::Landmarks) {
+        ensureLandmarks();
+    }
+    
+    // Workspace dist holds gScore (actual cost from start); the heap is keyed on fScore
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+    
+    ws.setDist(startNode, 0.0, -1);
+    ws.push(heuristicDistance(startNode, endNode), startNode);
+    
+    while (!ws.heapEmpty()) {
+        int u = ws.pop().second;
+        
+        if (u == endNode) break;
+        
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
+        
+        double gU = ws.getDist(u);
+        for (int e = graph.getEdgeBegin(u); e < graph.getEdgeEnd(u); ++e) {
+            int v = graph.targets[e];
+            double weight = graph.weights[e];
+            double tentativeG = gU + weight;
+            
+            if (tentativeG < ws.getDist(v)) {
+                ws.setDist(v, tentativeG, u);
+                
+                // An infinite bound proves endNode is unreachable from v
+                double h = heuristicDistance(v, endNode);
+                if (h != INF) {
+                    ws.push(tentativeG + h, v);
+                }
+            }
+        }
+    }
+    
+    return reconstructFromWorkspace(ws, startNode, endNode);
+}
+
+Path findConstrainedPath(int startNode, int endNode, const PathConstraints& constraints) {
+    Path invalidPath;
+    invalidPath.found = false;
+    invalidPath.totalDistance = INF;
+    
+    if (startNode < 0 || startNode >= static_cast<int>(nodes.size()) ||
+        endNode < 0 || endNode >= static_cast<int>(nodes.size())) {
+        return invalidPath;
+    }
     
-    // Priority queue: (fScore, node)
-    std::priority_queue<std::pair<double, int>, 
-                       std::vector<std::pair<double, int>>,
-                       std::greater<std::pair<double, int>>> pq;
+    if (!constraints.isNodeAllowed(startNode, true) || !constraints.isNodeAllowed(endNode, startNode == endNode)) {
+        return invalidPath;
+    }
+    
+    if (startNode == endNode) {
+        Path trivialPath;
+        trivialPath.nodes.push_back(startNode);
+        trivialPath.totalDistance = 0.0;
+        trivialPath.found = true;
+        return trivialPath;
+    }
     
-    gScore[startNode] = 0.0;
-    fScore[startNode] = heuristicDistance(startNode, endNode);
-    pq.push({fScore[startNode], startNode});
+    // Both may reuse the workspace, so they have to run before the search
+    if (heuristicMode == HeuristicMode::Landmarks) {
+        ensureLandmarks();
+    }
+    constraints.resolveEdges();
+    
+    // Constraints only remove edges, so the unconstrained heuristic stays admissible
+    const CSRGraph& graph = getCSRGraph();
+    SearchWorkspace& ws = getSearchWorkspace();
+    ws.reset(graph.nodeCount);
+    
+    ws.setDist(startNode, 0.0, -1);
+    ws.push(heuristicDistance(startNode, endNode), startNode);
     
-    while (!pq.empty()) {
-        auto [currentF, u] = pq.top();
-        pq.pop();
+    while (!ws.heapEmpty()) {
+        int u = ws.pop().second;
         
         if (u == endNode) break;
         
-        if (visited[u]) continue;
-        visited[u] = true;
+        if (ws.isClosed(u)) continue;
+        ws.close(u);
         
-        for (const Edge& edge : adj[u]) {
-            int v = edge.to;
-            double weight = edge.distance;
-            double tentativeG = gScore[u] + weight;
+        double gU = ws.getDist(u);
+        for (int e = graph.getEdgeBegin(u); e < graph.getEdgeEnd(u); ++e) {
+            int v = graph.targets[e];
+            double tentativeG = gU + graph.weights[e];
+            
+            if (tentativeG >= ws.getDist(v) || !constraints.isEdgeAllowed(e)) {
+                continue;
+            }
             
-            if (tentativeG < gScore[v]) {
-                gScore[v] = tentativeG;
-                fScore[v] = gScore[v] + heuristicDistance(v, endNode);
-                pred[v] = u;
-                pq.push({fScore[v], v});
+            // Each node is tested once; a rejected node is closed with its
+            // distance pinned to -INF so no later edge tries it again
+            if (!ws.isSeen(v) && !constraints.isNodeAllowed(v)) {
+                ws.setDist(v, -INF, -1);
+                ws.close(v);
+                continue;
+            }
+            
+            ws.setDist(v, tentativeG, u);
+            double h = heuristicDistance(v, endNode);
+            if (h != INF) {
+                ws.push(tentativeG + h, v);
             }
         }
     }
     
-    return reconstructPath(startNode, endNode, pred, gScore);
-}
\ No newline at end of file
+    return reconstructFromWorkspace(ws, startNode, endNode);
+}
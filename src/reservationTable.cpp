@@ -0,0 +1,162 @@
+#include "../includes/reservationTable.hpp"
+#include "../includes/csrGraph.hpp"
+#include <algorithm>
+
+ReservationTable reservationTable;
+
+static const double INF_TIME = std::numeric_limits<double>::infinity();
+
+// Insert keeping the list sorted on start (lists are short and mostly appended)
+static void insertSorted(std::vector<Reservation>& list, const Reservation& r) {
+    auto it = std::upper_bound(list.begin(), list.end(), r.start,
+                               [](double t, const Reservation& x) { return t < x.start; });
+    list.insert(it, r);
+}
+
+// First entry that can still overlap a window starting at 'from'
+static std::vector<Reservation>::const_iterator firstCandidate(const std::vector<Reservation>& list,
+                                                              double from, double maxDuration) {
+    return std::lower_bound(list.begin(), list.end(), from - maxDuration,
+                            [](const Reservation& x, double t) { return x.start < t; });
+}
+
+void ReservationTable::reset() {
+    const CSRGraph& graph = getCSRGraph();
+    nodeCount = graph.nodeCount;
+    edgeCount = graph.getEdgeCount();
+    builtForVersion = graphVersion;
+
+    nodeReservations.assign(nodeCount, {});
+    nodeMaxDuration.assign(nodeCount, 0.0);
+    parked.assign(nodeCount, {});
+    edgeReservations.assign(edgeCount, {});
+    edgeMaxDuration.assign(edgeCount, 0.0);
+}
+
+void ReservationTable::reserveNode(int node, double start, double end, int robot) {
+    if (node < 0 || node >= nodeCount || end <= start) return;
+
+    if (end == INF_TIME) {
+        parked[node].push_back({start, end, robot});
+        return;
+    }
+    insertSorted(nodeReservations[node], {start, end, robot});
+    nodeMaxDuration[node] = std::max(nodeMaxDuration[node], end - start);
+}
+
+void ReservationTable::reserveEdge(int edgeId, double start, double end, int robot) {
+    if (edgeId < 0 || edgeId >= edgeCount || end <= start) return;
+
+    insertSorted(edgeReservations[edgeId], {start, end, robot});
+    edgeMaxDuration[edgeId] = std::max(edgeMaxDuration[edgeId], end - start);
+}
+
+void ReservationTable::getFreeWindows(int node, double from, double to, int ignoreRobot,
+                                      std::vector<FreeWindow>& out) const {
+    out.clear();
+    if (node < 0 || node >= nodeCount) return;
+
+    int capacity = std::max(1, nodes[node].maxRobots);
+
+    // Sweep over +1/-1 events of the reservations that end after 'from'
+    thread_local std::vector<std::pair<double, int>> events;
+    events.clear();
+    int occupied = 0;
+
+    const std::vector<Reservation>& list = nodeReservations[node];
+    for (auto it = firstCandidate(list, from, nodeMaxDuration[node]); it != list.end(); ++it) {
+        if (it->robot == ignoreRobot || it->end <= from) continue;
+        if (it->start <= from) {
+            ++occupied;
+        } else {
+            events.emplace_back(it->start, +1);
+        }
+        events.emplace_back(it->end, -1);
+    }
+    for (const Reservation& r : parked[node]) {
+        if (r.robot == ignoreRobot) continue;
+        if (r.start <= from) {
+            ++occupied;
+        } else {
+            events.emplace_back(r.start, +1);
+        }
+    }
+
+    // Releases sort before arrivals at the same instant
+    std::sort(events.begin(), events.end());
+
+    double windowStart = occupied < capacity ? from : INF_TIME;
+    for (const auto& [time, delta] : events) {
+        occupied += delta;
+        if (occupied >= capacity && windowStart != INF_TIME) {
+            if (time > windowStart) out.push_back({windowStart, time});
+            windowStart = INF_TIME;
+            if (time > to) return;
+        } else if (occupied < capacity && windowStart == INF_TIME) {
+            if (time > to) return;
+            windowStart = time;
+        }
+    }
+    if (windowStart != INF_TIME && windowStart <= to) {
+        out.push_back({windowStart, INF_TIME});
+    }
+}
+
+double ReservationTable::getEdgeBlockedUntil(int edgeId, double start, double end, int ignoreRobot) const {
+    double blockedUntil = -INF_TIME;
+    if (edgeId < 0 || edgeId >= edgeCount) return blockedUntil;
+
+    const std::vector<Reservation>& list = edgeReservations[edgeId];
+    for (auto it = firstCandidate(list, start, edgeMaxDuration[edgeId]); it != list.end(); ++it) {
+        if (it->start >= end) break;
+        if (it->robot == ignoreRobot || it->end <= start) continue;
+        blockedUntil = std::max(blockedUntil, it->end);
+    }
+    return blockedUntil;
+}
+
+void ReservationTable::releaseRobot(int robot) {
+    auto ownedBy = [robot](const Reservation& r) { return r.robot == robot; };
+    for (std::vector<std::vector<Reservation>>* lists : {&nodeReservations, &parked, &edgeReservations}) {
+        for (std::vector<Reservation>& list : *lists) {
+            list.erase(std::remove_if(list.begin(), list.end(), ownedBy), list.end());
+        }
+    }
+}
+
+void ReservationTable::releaseBefore(double time) {
+    auto finished = [time](const Reservation& r) { return r.end <= time; };
+    for (std::vector<std::vector<Reservation>>* lists : {&nodeReservations, &edgeReservations}) {
+        for (std::vector<Reservation>& list : *lists) {
+            list.erase(std::remove_if(list.begin(), list.end(), finished), list.end());
+        }
+    }
+}
+
+void ReservationTable::releaseRobotAtNode(int node, int robot) {
+    if (node < 0 || node >= nodeCount) return;
+
+    auto ownedBy = [robot](const Reservation& r) { return r.robot == robot; };
+    for (std::vector<Reservation>* list : {&nodeReservations[node], &parked[node]}) {
+        list->erase(std::remove_if(list->begin(), list->end(), ownedBy), list->end());
+    }
+}
+
+void ReservationTable::releaseRobotOnEdge(int edgeId, int robot) {
+    if (edgeId < 0 || edgeId >= edgeCount) return;
+
+    std::vector<Reservation>& list = edgeReservations[edgeId];
+    list.erase(std::remove_if(list.begin(), list.end(),
+                              [robot](const Reservation& r) { return r.robot == robot; }),
+               list.end());
+}
+
+size_t ReservationTable::getReservationCount() const {
+    size_t count = 0;
+    for (const std::vector<std::vector<Reservation>>* lists : {&nodeReservations, &parked, &edgeReservations}) {
+        for (const std::vector<Reservation>& list : *lists) {
+            count += list.size();
+        }
+    }
+    return count;
+}
@@ -4,12 +4,37 @@
 #include "../includes/helpFunctions.hpp"
 #include "../includes/logger.hpp"
 #include "../includes/pathfinding.hpp"
+#include "../includes/spaceTimePlanner.hpp"
+#include "../includes/congestion.hpp"
+#include "../includes/pathCache.hpp"
+#include "../includes/nearestQuery.hpp"
+#include "../includes/inventoryIndex.hpp"
 #include "../includes/datatypes.hpp"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 
 std::vector<Robot> robots;
 
+void updateRobotPosition(Robot& robot) {
+    int from = robot.getCurrentNode();
+    if (from < 0 || from >= static_cast<int>(nodes.size())) {
+        return;
+    }
+    
+    int to = robot.getTargetNode();
+    if (robot.getStatus() != RobotStatus::Moving || to < 0 || to >= static_cast<int>(nodes.size())) {
+        robot.setPosition(nodes[from].getX(), nodes[from].getY());
+        return;
+    }
+    
+    // Linear interpolation along the edge being traversed
+    double t = std::min(1.0, std::max(0.0, robot.getProgress()));
+    robot.setPosition(nodes[from].getX() + (nodes[to].getX() - nodes[from].getX()) * t,
+                      nodes[from].getY() + (nodes[to].getY() - nodes[from].getY()) * t);
+}
+
 void initRobots() {
     robots.clear();
     
@@ -20,7 +45,7 @@ void initRobots() {
         robot.setCurrentNode(chargingStationNode);
         robot.setTargetNode(-1);
         robot.setProgress(0.0);
-        robot.setPosition(0.0, 0.0);  // Could set based on node position
+        robot.setPosition(nodes[chargingStationNode].getX(), nodes[chargingStationNode].getY());
         robot.setStatus(RobotStatus::Idle);
         robot.setCarrying(false);
         robot.setHasOrder(false);
@@ -30,6 +55,10 @@ void initRobots() {
         robots.push_back(robot);
     }
     
+    if (isSpaceTimePlanningEnabled()) {
+        syncReservationsWithRobots(reservationTable, 0.0);
+    }
+    
     std::cerr << "[ROBOTS] Initialized " << robots.size() << " robots\n";
 }
 
@@ -49,8 +78,32 @@ bool startRobotMovement(int robotIdx, int targetNode) {
         return false;
     }
     
-    // Find path
-    Path path = findShortestPath(robot.getCurrentNode(), targetNode);
+    SharedPath sharedPath;
+    if (isSpaceTimePlanningEnabled()) {
+        // Plan around the other robots' bookings, then book this schedule
+        if (reservationTable.builtForVersion != graphVersion) {
+            syncReservationsWithRobots(reservationTable, currentSimTime);
+        }
+        reservationTable.releaseRobot(robotIdx);
+        
+        TimedPath timed = findTimedPath(reservationTable, robotIdx, robot.getCurrentNode(), targetNode,
+                                        currentSimTime, robot.getSpeed());
+        if (timed.isFound()) {
+            reserveTimedPath(reservationTable, robotIdx, timed);
+        } else {
+            reservationTable.reserveNode(robot.getCurrentNode(), currentSimTime,
+                                         std::numeric_limits<double>::infinity(), robotIdx);
+        }
+        sharedPath = std::make_shared<const Path>(std::move(timed.path));
+    } else if (isCongestionAwareRoutingEnabled()) {
+        // Cheapest route given current occupancy and recent traffic
+        sharedPath = std::make_shared<const Path>(findCongestionAwarePath(robot.getCurrentNode(), targetNode));
+    } else {
+        // Static routes repeat a lot (dock -> shelf -> front desk), so they
+        // come from the path cache and are shared instead of copied
+        sharedPath = getSharedPath(robot.getCurrentNode(), targetNode);
+    }
+    const Path& path = *sharedPath;
     
     if (!path.isFound()) {
         std::cerr << "[ROBOT] No path found from node " << robot.getCurrentNode() 
@@ -67,9 +120,8 @@ bool startRobotMovement(int robotIdx, int targetNode) {
         robot.setTargetNode(path.getNode(1));  // Next node after current
         robot.setStatus(RobotStatus::Moving);
         robot.setProgress(0.0);
-        robot.currentPath = path;
-        // Store full path in robot (you might want to add this to Robot struct)
-        // robot.currentPath = path;
+        robot.currentPath = sharedPath;
+        updateRobotPosition(robot);
         
         return true;
     }
@@ -133,23 +185,16 @@ void updateRobotMovement(int robotIdx, double deltaTime, const Path& fullPath) {
             robot.setProgress(0.0);
         }
     }
+    
+    updateRobotPosition(robot);
 }
 
 // Find product on shelf
 int findProductOnShelf(int productID, int& outSlotIndex) {
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (nodes[i].getType() != NodeType::Shelf) continue;
-        
-        const Shelf* shelf = nodes[i].getShelf();
-        if (!shelf) continue;
-        
-        for (int j = 0; j < shelf->getSlotCount(); ++j) {
-            Slot slot = shelf->getSlot(j);
-            if (slot.getProductID() == productID && slot.getOccupied() > 0) {
-                outSlotIndex = j;
-                return i;  // Return shelf node index
-            }
-        }
+    SlotRef ref;
+    if (findSlotWithStock(productID, 1, ref)) {
+        outSlotIndex = ref.slot;
+        return ref.node;  // Return shelf node index
     }
     
     outSlotIndex = -1;
@@ -247,6 +292,11 @@ std::map<std::string, double> step_simulation(
             
             // Calculate distance and battery cost
             double distance = calculateDistance(robot.currentNode, targetNode);
+            if (!std::isfinite(distance)) {
+                result["blocked"] = 1;
+                std::cerr << "Robot " << robotIdx << " cannot reach node " << targetNode << "\n";
+                break;
+            }
             double batteryUsed = distance * 0.5; // 0.5% per meter
             
             if (robot.battery < batteryUsed) {
@@ -261,6 +311,7 @@ std::map<std::string, double> step_simulation(
             nodes[robot.currentNode].currentRobots++;
             robot.battery -= batteryUsed;
             robot.status = RobotStatus::Idle;
+            updateRobotPosition(robot);
             
             result["battery_used"] = batteryUsed;
             
@@ -347,6 +398,7 @@ std::map<std::string, double> step_simulation(
                         break;
                     }
                 }
+                releaseBackorders(robot.currentOrder.productID);
                 
                 result["order_completed"] = 1;
             if (globalLogger != nullptr) {
@@ -363,13 +415,13 @@ std::map<std::string, double> step_simulation(
         }
         
         case 3: { // CHARGE
-            if (robot.currentNode != chargingStationNode) {
-                // Robot not at charging station - need to move there first
+            if (!nodes[robot.currentNode].isChargingStation()) {
+                // Robot not at a charging station - need to move there first
                 result["order_failed"] = 1;
                 break;
             }
             
-            auto& chargeData = std::get<ChargingStation>(nodes[chargingStationNode].data);
+            auto& chargeData = std::get<ChargingStation>(nodes[robot.currentNode].data);
             
             if (chargeData.isOccupied >= chargeData.chargingPorts) {
                 result["blocked"] = 1;
@@ -392,18 +444,19 @@ std::map<std::string, double> step_simulation(
         
         case 4: { // TRANSFER TASK
             // Handover task to nearest available robot
-            int nearestRobot = -1;
-            double minDistance = 1000.0;
+            // One search outwards from this robot instead of a distance query per robot
+            int nearestRobot = findNearestRobot(robot.currentNode, [robotIdx](int i) {
+                return i != robotIdx && !robots[i].hasOrder && robots[i].battery >= 20.0;
+            }, 1000.0);
             
-            for (size_t i = 0; i < robots.size(); ++i) {
-                if (i == static_cast<size_t>(robotIdx)) continue;
-                if (robots[i].hasOrder) continue;
-                if (robots[i].battery < 20.0) continue;
-                
-                double dist = calculateDistance(robot.currentNode, robots[i].currentNode);
-                if (dist < minDistance) {
-                    minDistance = dist;
-                    nearestRobot = i;
+            // The new robot must be able to reach the target
+            double newDistance = std::numeric_limits<double>::infinity();
+            if (nearestRobot != -1) {
+                newDistance = calculateDistance(robots[nearestRobot].currentNode, targetNode);
+                if (!std::isfinite(newDistance)) {
+                    std::cerr << "Robot " << nearestRobot << " cannot reach node " << targetNode
+                              << " - handover cancelled\n";
+                    nearestRobot = -1;
                 }
             }
             
@@ -415,10 +468,11 @@ std::map<std::string, double> step_simulation(
                 robot.currentOrder = Order();
                 robot.hasOrder = false;
                 
-                // Calculate distance saved
+                // Calculate distance saved (none counted if this robot could not reach the target)
                 double originalDistance = calculateDistance(robot.currentNode, targetNode);
-                double newDistance = calculateDistance(robots[nearestRobot].currentNode, targetNode);
-                result["distance_saved"] = std::max(0.0, originalDistance - newDistance);
+                if (std::isfinite(originalDistance)) {
+                    result["distance_saved"] = std::max(0.0, originalDistance - newDistance);
+                }
                 result["handover_success"] = 1;
                 
                 std::cerr << "Task handed over from Robot " << robotIdx 
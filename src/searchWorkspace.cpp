@@ -0,0 +1,11 @@
+#include "../includes/searchWorkspace.hpp"
+
+SearchWorkspace& getSearchWorkspace() {
+    thread_local SearchWorkspace workspace;
+    return workspace;
+}
+
+SearchWorkspace& getReverseSearchWorkspace() {
+    thread_local SearchWorkspace workspace;
+    return workspace;
+}
@@ -0,0 +1,205 @@
+#include "../includes/spaceTimePlanner.hpp"
+#include "../includes/csrGraph.hpp"
+#include "../includes/pathfinding.hpp"
+#include "../includes/robot.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+static const double INF_TIME = std::numeric_limits<double>::infinity();
+
+static bool spaceTimePlanning = false;
+
+namespace {
+
+// Search state: a node together with the free window the robot arrived in
+struct TimedState {
+    int node;
+    double arrival;
+    double windowEnd;
+    double distance;           // Path length so far
+    double parentDeparture;    // When the robot left the previous node
+    int parent;
+};
+
+struct StateKey {
+    int node;
+    double windowEnd;
+    bool operator==(const StateKey& other) const {
+        return node == other.node && windowEnd == other.windowEnd;
+    }
+};
+
+struct StateKeyHash {
+    size_t operator()(const StateKey& key) const {
+        return std::hash<int>()(key.node) * 31 + std::hash<double>()(key.windowEnd);
+    }
+};
+
+// Latest end of any other robot's trip from 'from' to 'to' that overlaps [start, end)
+double oppositeTrafficUntil(const ReservationTable& table, const CSRGraph& graph, int from, int to,
+                            double start, double end, int robot) {
+    double blockedUntil = -INF_TIME;
+    for (int e = graph.getEdgeBegin(from); e < graph.getEdgeEnd(from); ++e) {
+        if (graph.targets[e] == to) {
+            blockedUntil = std::max(blockedUntil, table.getEdgeBlockedUntil(e, start, end, robot));
+        }
+    }
+    return blockedUntil;
+}
+
+} // namespace
+
+void setSpaceTimePlanning(bool enabled) {
+    spaceTimePlanning = enabled;
+}
+
+bool isSpaceTimePlanningEnabled() {
+    return spaceTimePlanning;
+}
+
+// Safe-interval A*: instead of one state per (node, time step) there is one
+// per (node, free window). Within a window the earliest arrival dominates,
+// since the robot can always wait there. Waiting happens implicitly by
+// arriving later than the earliest possible time.
+TimedPath findTimedPath(const ReservationTable& table, int robot, int startNode, int goalNode,
+                        double startTime, double speed, double horizon) {
+    TimedPath result;
+    result.path.found = false;
+    result.path.totalDistance = std::numeric_limits<double>::infinity();
+
+    const CSRGraph& graph = getCSRGraph();
+    if (startNode < 0 || startNode >= graph.nodeCount || goalNode < 0 || goalNode >= graph.nodeCount ||
+        speed <= 0.0 || table.nodeCount != graph.nodeCount || table.edgeCount != graph.getEdgeCount()) {
+        return result;
+    }
+
+    thread_local std::vector<TimedState> states;
+    thread_local std::unordered_map<StateKey, int, StateKeyHash> bestState;
+    thread_local std::vector<std::pair<double, int>> heap;
+    thread_local std::vector<FreeWindow> windows;
+    states.clear();
+    bestState.clear();
+    heap.clear();
+
+    auto pushState = [&](const TimedState& state) {
+        double h = heuristicDistance(state.node, goalNode);
+        if (h == std::numeric_limits<double>::infinity()) return;
+
+        StateKey key{state.node, state.windowEnd};
+        auto it = bestState.find(key);
+        if (it != bestState.end() && states[it->second].arrival <= state.arrival) return;
+
+        int index = static_cast<int>(states.size());
+        states.push_back(state);
+        bestState[key] = index;
+        heap.emplace_back(state.arrival + h / speed, index);
+        std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<double, int>>());
+    };
+
+    // If the start is already over capacity the robot may only leave right away
+    table.getFreeWindows(startNode, startTime, startTime, robot, windows);
+    double startWindowEnd = (!windows.empty() && windows[0].start <= startTime)
+        ? windows[0].end : startTime + NODE_CLEARANCE;
+    pushState({startNode, startTime, startWindowEnd, 0.0, startTime, -1});
+
+    double deadline = startTime + horizon;
+    int goalState = -1;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<std::pair<double, int>>());
+        int index = heap.back().second;
+        heap.pop_back();
+
+        const TimedState current = states[index];
+        if (bestState[StateKey{current.node, current.windowEnd}] != index) continue;
+
+        // Done once the robot can stay at the goal for good
+        if (current.node == goalNode && current.windowEnd == INF_TIME) {
+            goalState = index;
+            break;
+        }
+
+        double latestDeparture = current.windowEnd - NODE_CLEARANCE;
+        for (int e = graph.getEdgeBegin(current.node); e < graph.getEdgeEnd(current.node); ++e) {
+            int v = graph.targets[e];
+            double travel = graph.weights[e] / speed;
+            double earliestArrival = current.arrival + travel;
+            double latestArrival = std::min(latestDeparture + travel, deadline);
+            if (earliestArrival > latestArrival) continue;
+
+            table.getFreeWindows(v, earliestArrival, latestArrival, robot, windows);
+            for (const FreeWindow& window : windows) {
+                double arrival = std::max(window.start, earliestArrival);
+
+                // Let robots coming the other way clear the edge first (no swaps)
+                bool edgeFree = false;
+                for (int attempt = 0; attempt < 8 && arrival <= latestArrival; ++attempt) {
+                    double blockedUntil = oppositeTrafficUntil(table, graph, v, current.node,
+                                                               arrival - travel, arrival, robot);
+                    if (blockedUntil == -INF_TIME) {
+                        edgeFree = true;
+                        break;
+                    }
+                    arrival = blockedUntil + travel;
+                }
+
+                if (!edgeFree || arrival > latestArrival || arrival + NODE_CLEARANCE > window.end) {
+                    continue;
+                }
+
+                pushState({v, arrival, window.end, current.distance + graph.weights[e],
+                           arrival - travel, index});
+            }
+        }
+    }
+
+    if (goalState == -1) {
+        return result;
+    }
+
+    int hops = 0;
+    for (int s = goalState; s != -1; s = states[s].parent) {
+        ++hops;
+    }
+
+    result.path.nodes.resize(hops);
+    result.arrivalTimes.resize(hops);
+    result.departureTimes.resize(hops);
+    double departure = INF_TIME;
+    for (int s = goalState, i = hops - 1; s != -1; s = states[s].parent, --i) {
+        result.path.nodes[i] = states[s].node;
+        result.arrivalTimes[i] = states[s].arrival;
+        result.departureTimes[i] = departure;
+        departure = states[s].parentDeparture;
+    }
+    result.path.totalDistance = states[goalState].distance;
+    result.path.found = true;
+
+    return result;
+}
+
+void reserveTimedPath(ReservationTable& table, int robot, const TimedPath& timedPath) {
+    if (!timedPath.isFound()) return;
+
+    const CSRGraph& graph = getCSRGraph();
+    const std::vector<int>& pathNodes = timedPath.path.nodes;
+
+    for (size_t i = 0; i < pathNodes.size(); ++i) {
+        double arrival = timedPath.arrivalTimes[i];
+        double departure = timedPath.departureTimes[i];
+        double holdUntil = departure == INF_TIME ? INF_TIME : departure + NODE_CLEARANCE;
+        table.reserveNode(pathNodes[i], arrival, holdUntil, robot);
+
+        if (i + 1 < pathNodes.size()) {
+            int edge = lightestEdge(graph, pathNodes[i], pathNodes[i + 1]);
+            table.reserveEdge(edge, departure, timedPath.arrivalTimes[i + 1], robot);
+        }
+    }
+}
+
+void syncReservationsWithRobots(ReservationTable& table, double time) {
+    table.reset();
+    for (size_t i = 0; i < robots.size(); ++i) {
+        table.reserveNode(robots[i].getCurrentNode(), time, INF_TIME, static_cast<int>(i));
+    }
+}
@@ -0,0 +1,95 @@
+#include "../includes/threadPool.hpp"
+#include <algorithm>
+
+// True on pool workers and on a caller while it runs its share of a job
+static thread_local bool insideParallelFor = false;
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int t = 1; t < threadCount; ++t) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::runChunks() {
+    while (true) {
+        int begin = nextIndex.fetch_add(jobChunk);
+        if (begin >= jobCount) break;
+        int end = std::min(jobCount, begin + jobChunk);
+        for (int i = begin; i < end; ++i) {
+            (*job)(i);
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    insideParallelFor = true;
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [&]() { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--activeWorkers == 0) {
+                workDone.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& fn, int chunk) {
+    if (count <= 0) return;
+    chunk = std::max(1, chunk);
+
+    // Not worth waking anyone, or already inside a job
+    if (workers.empty() || count <= chunk || insideParallelFor) {
+        for (int i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(jobMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        jobChunk = chunk;
+        nextIndex = 0;
+        activeWorkers = static_cast<int>(workers.size());
+        ++jobGeneration;
+    }
+    workReady.notify_all();
+
+    insideParallelFor = true;
+    runChunks();
+    insideParallelFor = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [&]() { return activeWorkers == 0; });
+    job = nullptr;
+}
+
+ThreadPool& getThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,110 @@
+#include "../includes/weightedSampler.hpp"
+#include "../includes/datatypes.hpp"
+#include <algorithm>
+
+namespace {
+
+WeightedSampler orderSampler;
+WeightedSampler deliverySampler;
+
+// Populära produkter beställs oftare, impopulära levereras oftare
+long long orderWeight(const Product& p) {
+    return std::max(0, p.getPopularity()) + 1;
+}
+
+long long deliveryWeight(const Product& p) {
+    return std::max(1, 10 - p.getPopularity());
+}
+
+void ensureSamplers() {
+    if (orderSampler.size() != products.size()) {
+        rebuildProductDemand();
+    }
+}
+
+} // namespace
+
+void WeightedSampler::build(const std::vector<long long>& newWeights) {
+    weights.assign(newWeights.size(), 0);
+    tree.assign(newWeights.size() + 1, 0);
+    total = 0;
+
+    for (size_t i = 0; i < newWeights.size(); ++i) {
+        weights[i] = std::max(0LL, newWeights[i]);
+        total += weights[i];
+        tree[i + 1] += weights[i];
+        size_t parent = (i + 1) + ((i + 1) & (~(i + 1) + 1));
+        if (parent < tree.size()) tree[parent] += tree[i + 1];
+    }
+
+    highestStep = 1;
+    while (highestStep * 2 <= weights.size()) highestStep *= 2;
+}
+
+void WeightedSampler::update(size_t i, long long weight) {
+    if (i >= weights.size()) return;
+
+    weight = std::max(0LL, weight);
+    long long delta = weight - weights[i];
+    if (delta == 0) return;
+
+    weights[i] = weight;
+    total += delta;
+    for (size_t k = i + 1; k < tree.size(); k += k & (~k + 1)) {
+        tree[k] += delta;
+    }
+}
+
+int WeightedSampler::sample(std::mt19937& generator) const {
+    if (total <= 0) return -1;
+
+    std::uniform_int_distribution<long long> pick(0, total - 1);
+    long long target = pick(generator);
+
+    // Descend to the last position whose prefix sum is <= target; the
+    // next index is the one whose weight range covers target
+    size_t pos = 0;
+    for (size_t step = highestStep; step > 0; step /= 2) {
+        if (pos + step < tree.size() && tree[pos + step] <= target) {
+            pos += step;
+            target -= tree[pos];
+        }
+    }
+    return static_cast<int>(pos);
+}
+
+int sampleOrderProductIndex(std::mt19937& generator) {
+    ensureSamplers();
+    return orderSampler.sample(generator);
+}
+
+int sampleDeliveryProductIndex(std::mt19937& generator) {
+    ensureSamplers();
+    return deliverySampler.sample(generator);
+}
+
+void updateProductDemand(size_t productIdx) {
+    if (orderSampler.size() != products.size()) {
+        rebuildProductDemand();
+        return;
+    }
+    if (productIdx >= products.size()) return;
+
+    orderSampler.update(productIdx, orderWeight(products[productIdx]));
+    deliverySampler.update(productIdx, deliveryWeight(products[productIdx]));
+}
+
+void rebuildProductDemand() {
+    std::vector<long long> orderWeights;
+    std::vector<long long> deliveryWeights;
+    orderWeights.reserve(products.size());
+    deliveryWeights.reserve(products.size());
+
+    for (const Product& p : products) {
+        orderWeights.push_back(orderWeight(p));
+        deliveryWeights.push_back(deliveryWeight(p));
+    }
+
+    orderSampler.build(orderWeights);
+    deliverySampler.build(deliveryWeights);
+}